@@ -0,0 +1,240 @@
+#include "SplineFollowerMassSubsystem.h"
+#include "SplineMassFragments.h"
+#include "SplineFollowerSubsystem.h"
+#include "SplineLibrarySubsystem.h"
+#include "Components/SplineComponent.h"
+#include "Engine/World.h"
+#include "MassEntityConfigAsset.h"
+#include "MassEntityManager.h"
+#include "MassEntityUtils.h"
+#include "MassCommonFragments.h"
+
+bool USplineFollowerMassSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USplineFollowerMassSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (USplineLibrarySubsystem* LibrarySubsystem = Collection.InitializeDependency<USplineLibrarySubsystem>())
+    {
+        LibraryChangedHandle = LibrarySubsystem->OnLibraryChanged.AddUObject(this, &USplineFollowerMassSubsystem::ClearLibraryRoutes);
+    }
+}
+
+void USplineFollowerMassSubsystem::Deinitialize()
+{
+    if (USplineLibrarySubsystem* LibrarySubsystem = GetWorld()->GetSubsystem<USplineLibrarySubsystem>())
+    {
+        LibrarySubsystem->OnLibraryChanged.Remove(LibraryChangedHandle);
+    }
+    LibraryChangedHandle.Reset();
+
+    Routes.Empty();
+
+    Super::Deinitialize();
+}
+
+int32 USplineFollowerMassSubsystem::SpawnFollowers(UMassEntityConfigAsset* Config, USplineComponent* Spline, int32 Count, float Speed)
+{
+    TArray<FMassEntityHandle> Entities;
+    return SpawnFollowers(Config, Spline, Count, Speed, Entities);
+}
+
+int32 USplineFollowerMassSubsystem::SpawnFollowers(UMassEntityConfigAsset* Config, USplineComponent* Spline, int32 Count, float Speed, TArray<FMassEntityHandle>& OutEntities)
+{
+    if (!Config || !Spline || Count <= 0)
+    {
+        return 0;
+    }
+
+    return SpawnOnRoute(Config, FindOrAddRoute(Spline), Count, Speed, OutEntities);
+}
+
+int32 USplineFollowerMassSubsystem::SpawnLibraryFollowers(UMassEntityConfigAsset* Config, int32 LibrarySplineIndex, int32 Count, float Speed)
+{
+    TArray<FMassEntityHandle> Entities;
+    return SpawnLibraryFollowers(Config, LibrarySplineIndex, Count, Speed, Entities);
+}
+
+int32 USplineFollowerMassSubsystem::SpawnLibraryFollowers(UMassEntityConfigAsset* Config, int32 LibrarySplineIndex, int32 Count, float Speed, TArray<FMassEntityHandle>& OutEntities)
+{
+    if (!Config || Count <= 0)
+    {
+        return 0;
+    }
+
+    const int32 RouteIndex = FindOrAddLibraryRoute(LibrarySplineIndex);
+    if (RouteIndex == INDEX_NONE)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Spline %d is not in the open spline library."), LibrarySplineIndex);
+        return 0;
+    }
+
+    return SpawnOnRoute(Config, RouteIndex, Count, Speed, OutEntities);
+}
+
+int32 USplineFollowerMassSubsystem::SpawnOnRoute(UMassEntityConfigAsset* Config, int32 RouteIndex, int32 Count, float Speed, TArray<FMassEntityHandle>& OutEntities)
+{
+    UWorld* World = GetWorld();
+    const FMassEntityTemplate& Template = Config->GetOrCreateEntityTemplate(*World);
+    if (!Template.GetCompositionDescriptor().Fragments.Contains<FSplineFollowerFragment>())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s has no Spline Follower trait."), *Config->GetName());
+        return 0;
+    }
+
+    const FSplineMassRoute& Route = Routes[RouteIndex];
+    const float SplineLength = Route.SplineLength;
+    const double ServerTime = FSplineFollowState::GetServerTime(World);
+
+    FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(*World);
+
+    const int32 FirstNewEntity = OutEntities.Num();
+    TArray<FMassEntityHandle> Entities;
+    {
+        // Observers run when the creation context goes out of scope, after the fragments were filled in
+        TSharedRef<FMassEntityManager::FEntityCreationContext> CreationContext = EntityManager.BatchCreateEntities(Template.GetArchetype(), Template.GetSharedFragmentValues(), Count, Entities);
+
+        for (int32 i = 0; i < Entities.Num(); ++i)
+        {
+            FSplineFollowerFragment& Follower = EntityManager.GetFragmentDataChecked<FSplineFollowerFragment>(Entities[i]);
+            Follower.RouteIndex = RouteIndex;
+            Follower.State.StartDistance.Set(SplineLength * i / Count, SplineLength, FSplineQuantizedDistance::MaxBits);
+            Follower.State.StartServerTime = ServerTime;
+            Follower.State.Speed = Speed;
+            Follower.State.bIsFollowing = true;
+            Follower.Distance = Follower.State.StartDistance.Get(SplineLength);
+
+            FVector Location = Route.ComponentToWorld.GetLocation();
+            FRotator Rotation = FRotator::ZeroRotator;
+            if (Route.Table.IsValid())
+            {
+                Route.Table->SampleWorld(Follower.Distance, Route.ComponentToWorld, Location, Rotation);
+            }
+
+            EntityManager.GetFragmentDataChecked<FTransformFragment>(Entities[i]).SetTransform(FTransform(Rotation, Location));
+        }
+    }
+
+    Routes[RouteIndex].NumEntities += Entities.Num();
+
+    OutEntities.Append(Entities);
+    return OutEntities.Num() - FirstNewEntity;
+}
+
+void USplineFollowerMassSubsystem::DestroyFollowers(const TArray<FMassEntityHandle>& Entities)
+{
+    FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(*GetWorld());
+
+    for (const FMassEntityHandle& Entity : Entities)
+    {
+        const FSplineFollowerFragment* Follower = EntityManager.IsEntityValid(Entity) ? EntityManager.GetFragmentDataPtr<FSplineFollowerFragment>(Entity) : nullptr;
+        if (Follower && Routes.IsValidIndex(Follower->RouteIndex))
+        {
+            FSplineMassRoute& Route = Routes[Follower->RouteIndex];
+
+            // Let the library page out a spline nobody follows anymore
+            if (--Route.NumEntities <= 0 && Route.LibraryIndex != INDEX_NONE)
+            {
+                Route.NumEntities = 0;
+                Route.Table.Reset();
+            }
+        }
+    }
+
+    EntityManager.Defer().DestroyEntities(Entities);
+}
+
+int32 USplineFollowerMassSubsystem::FindOrAddRoute(USplineComponent* Spline)
+{
+    const int32 ExistingIndex = Routes.IndexOfByPredicate([Spline](const FSplineMassRoute& Route) { return Route.Spline.Get() == Spline; });
+    if (ExistingIndex != INDEX_NONE)
+    {
+        return ExistingIndex;
+    }
+
+    FSplineMassRoute& Route = Routes.AddDefaulted_GetRef();
+    Route.Spline = Spline;
+    Route.ComponentToWorld = Spline->GetComponentTransform();
+    Route.SplineLength = Spline->GetSplineLength();
+
+    if (USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>())
+    {
+        Route.Table = FollowerSubsystem->FindOrBuildDistanceTable(Spline, BakedSampleSpacing, BakedMaxError);
+    }
+
+    return Routes.Num() - 1;
+}
+
+int32 USplineFollowerMassSubsystem::FindOrAddLibraryRoute(int32 LibrarySplineIndex)
+{
+    const int32 ExistingIndex = Routes.IndexOfByPredicate([LibrarySplineIndex](const FSplineMassRoute& Route) { return Route.LibraryIndex == LibrarySplineIndex; });
+    if (ExistingIndex != INDEX_NONE && Routes[ExistingIndex].Table.IsValid())
+    {
+        return ExistingIndex;
+    }
+
+    USplineLibrarySubsystem* LibrarySubsystem = GetWorld()->GetSubsystem<USplineLibrarySubsystem>();
+    TSharedPtr<const FSplineDistanceTable> Table = LibrarySubsystem ? LibrarySubsystem->AcquireSplineTable(LibrarySplineIndex) : nullptr;
+    if (!Table.IsValid())
+    {
+        return INDEX_NONE;
+    }
+
+    // The route keeps the library spline paged in while its entities exist
+    FSplineMassRoute& Route = ExistingIndex != INDEX_NONE ? Routes[ExistingIndex] : Routes.AddDefaulted_GetRef();
+    Route.LibraryIndex = LibrarySplineIndex;
+    Route.Table = Table;
+    Route.ComponentToWorld = FTransform::Identity;
+    Route.SplineLength = Table->GetSplineLength();
+
+    return ExistingIndex != INDEX_NONE ? ExistingIndex : Routes.Num() - 1;
+}
+
+void USplineFollowerMassSubsystem::ClearLibraryRoutes()
+{
+    // Route indices stay stable for the entities on them, the routes just no longer match any library spline.
+    // Without a spline or a table such a route is skipped like one whose spline was destroyed
+    for (FSplineMassRoute& Route : Routes)
+    {
+        if (Route.LibraryIndex != INDEX_NONE)
+        {
+            Route.LibraryIndex = INDEX_NONE;
+            Route.Table.Reset();
+            Route.NumEntities = 0;
+        }
+    }
+}
+
+void USplineFollowerMassSubsystem::RefreshRoutes()
+{
+    USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>();
+
+    for (FSplineMassRoute& Route : Routes)
+    {
+        // Library routes are baked and never change
+        if (Route.LibraryIndex != INDEX_NONE)
+        {
+            continue;
+        }
+
+        const USplineComponent* Spline = Route.Spline.Get();
+        if (!Spline)
+        {
+            // Entities on a destroyed spline stop where they are
+            Route.Table.Reset();
+            continue;
+        }
+
+        Route.ComponentToWorld = Spline->GetComponentTransform();
+        Route.SplineLength = Spline->GetSplineLength();
+
+        if (FollowerSubsystem && (!Route.Table.IsValid() || !Route.Table->IsUpToDate(*Spline)))
+        {
+            Route.Table = FollowerSubsystem->FindOrBuildDistanceTable(Spline, BakedSampleSpacing, BakedMaxError);
+        }
+    }
+}
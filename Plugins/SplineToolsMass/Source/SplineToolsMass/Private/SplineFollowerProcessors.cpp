@@ -0,0 +1,203 @@
+#include "SplineFollowerProcessors.h"
+#include "SplineMassFragments.h"
+#include "SplineFollowerMassSubsystem.h"
+#include "SplineFollowerSubsystem.h"
+#include "SplineFollowerPoolSubsystem.h"
+#include "SplineFollowerBase.h"
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "Engine/World.h"
+#include "Components/SplineComponent.h"
+
+USplineFollowerMovementProcessor::USplineFollowerMovementProcessor()
+{
+    ExecutionFlags = (int32)EProcessorExecutionFlags::All;
+    ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::Movement;
+
+    // Routes are refreshed from their spline components before the chunks go wide
+    bRequiresGameThreadExecution = true;
+}
+
+void USplineFollowerMovementProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FSplineFollowerFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddTagRequirement<FSplineFollowerTag>(EMassFragmentPresence::All);
+    EntityQuery.RegisterWithProcessor(*this);
+}
+
+void USplineFollowerMovementProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    UWorld* World = EntityManager.GetWorld();
+    USplineFollowerMassSubsystem* MassSubsystem = World ? World->GetSubsystem<USplineFollowerMassSubsystem>() : nullptr;
+    if (!MassSubsystem)
+    {
+        return;
+    }
+
+    MassSubsystem->RefreshRoutes();
+
+    const TArray<FSplineMassRoute>& Routes = MassSubsystem->GetRoutes();
+    const double ServerTime = FSplineFollowState::GetServerTime(World);
+
+    // Only the baked tables are read here, no UObject is touched inside the chunks
+    EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [&Routes, ServerTime](FMassExecutionContext& ChunkContext)
+    {
+        const TArrayView<FSplineFollowerFragment> Followers = ChunkContext.GetMutableFragmentView<FSplineFollowerFragment>();
+        const TArrayView<FTransformFragment> Transforms = ChunkContext.GetMutableFragmentView<FTransformFragment>();
+
+        for (int32 i = 0; i < ChunkContext.GetNumEntities(); ++i)
+        {
+            FSplineFollowerFragment& Follower = Followers[i];
+            if (!Routes.IsValidIndex(Follower.RouteIndex))
+            {
+                continue;
+            }
+
+            const FSplineMassRoute& Route = Routes[Follower.RouteIndex];
+            const FSplineDistanceTable* Table = Route.Table.Get();
+            if (!Table)
+            {
+                continue;
+            }
+
+            Follower.Distance = Follower.State.GetDistanceAtTime(ServerTime, Route.SplineLength);
+
+            FVector Location;
+            FRotator Rotation;
+            Table->SampleWorld(Follower.Distance, Route.ComponentToWorld, Location, Rotation);
+            Transforms[i].SetTransform(FTransform(Rotation, Location));
+        }
+    });
+}
+
+USplineFollowerRepresentationProcessor::USplineFollowerRepresentationProcessor()
+{
+    // Clients receive the materialised actors through replication instead of spawning local copies
+    ExecutionFlags = (int32)(EProcessorExecutionFlags::Server | EProcessorExecutionFlags::Standalone);
+    ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::Representation;
+    ExecutionOrder.ExecuteAfter.Add(UE::Mass::ProcessorGroupNames::Movement);
+
+    // Spawns and releases actors
+    bRequiresGameThreadExecution = true;
+}
+
+void USplineFollowerRepresentationProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FSplineFollowerFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FSplineFollowerActorFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddConstSharedRequirement<FSplineFollowerRepresentationParams>();
+    EntityQuery.AddTagRequirement<FSplineFollowerTag>(EMassFragmentPresence::All);
+    EntityQuery.RegisterWithProcessor(*this);
+}
+
+void USplineFollowerRepresentationProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    UWorld* World = EntityManager.GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    const USplineFollowerSubsystem* FollowerSubsystem = World->GetSubsystem<USplineFollowerSubsystem>();
+    const USplineFollowerMassSubsystem* MassSubsystem = World->GetSubsystem<USplineFollowerMassSubsystem>();
+    USplineFollowerPoolSubsystem* Pool = World->GetSubsystem<USplineFollowerPoolSubsystem>();
+    if (!FollowerSubsystem || !MassSubsystem || !Pool)
+    {
+        return;
+    }
+
+    const TArray<FVector>& Viewers = FollowerSubsystem->GetViewerLocations();
+    const TArray<FSplineMassRoute>& Routes = MassSubsystem->GetRoutes();
+    const bool bNetworked = World->GetNetMode() != NM_Standalone;
+
+    EntityQuery.ForEachEntityChunk(EntityManager, Context, [&Viewers, &Routes, Pool, bNetworked](FMassExecutionContext& ChunkContext)
+    {
+        const FSplineFollowerRepresentationParams& Params = ChunkContext.GetConstSharedFragment<FSplineFollowerRepresentationParams>();
+        const TConstArrayView<FSplineFollowerFragment> Followers = ChunkContext.GetFragmentView<FSplineFollowerFragment>();
+        const TConstArrayView<FTransformFragment> Transforms = ChunkContext.GetFragmentView<FTransformFragment>();
+        const TArrayView<FSplineFollowerActorFragment> Actors = ChunkContext.GetMutableFragmentView<FSplineFollowerActorFragment>();
+
+        const float MaterializeDistanceSquared = FMath::Square(Params.MaterializeDistance);
+        const float DematerializeDistanceSquared = FMath::Square(FMath::Max(Params.DematerializeDistance, Params.MaterializeDistance));
+
+        for (int32 i = 0; i < ChunkContext.GetNumEntities(); ++i)
+        {
+            const FVector Location = Transforms[i].GetTransform().GetLocation();
+
+            // Without any viewer every entity stays lightweight
+            float ClosestDistanceSquared = TNumericLimits<float>::Max();
+            for (const FVector& Viewer : Viewers)
+            {
+                ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, static_cast<float>(FVector::DistSquared(Viewer, Location)));
+            }
+
+            ASplineFollowerBase* Actor = Actors[i].Actor.Get();
+            if (!Actor && ClosestDistanceSquared <= MaterializeDistanceSquared && Params.ActorClass)
+            {
+                USplineComponent* Spline = Routes.IsValidIndex(Followers[i].RouteIndex) ? Routes[Followers[i].RouteIndex].Spline.Get() : nullptr;
+                if (!Spline)
+                {
+                    continue;
+                }
+
+                // Replicated actors tell clients which spline they adopted, which needs a spline clients can resolve
+                if (bNetworked && !Spline->IsSupportedForNetworking())
+                {
+                    continue;
+                }
+
+                Actor = Pool->Acquire<ASplineFollowerBase>(Params.ActorClass, Transforms[i].GetTransform());
+                if (Actor)
+                {
+                    Actor->AdoptFollowState(Spline, Followers[i].State);
+                    Actors[i].Actor = Actor;
+                }
+            }
+            else if (Actor && ClosestDistanceSquared > DematerializeDistanceSquared)
+            {
+                Pool->ReleaseActor(Actor);
+                Actors[i].Actor.Reset();
+            }
+        }
+    });
+}
+
+USplineFollowerActorReleaseObserver::USplineFollowerActorReleaseObserver()
+{
+    ObservedType = FSplineFollowerActorFragment::StaticStruct();
+    Operation = EMassObservedOperation::Remove;
+    ExecutionFlags = (int32)(EProcessorExecutionFlags::Server | EProcessorExecutionFlags::Standalone);
+    bRequiresGameThreadExecution = true;
+}
+
+void USplineFollowerActorReleaseObserver::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FSplineFollowerActorFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.RegisterWithProcessor(*this);
+}
+
+void USplineFollowerActorReleaseObserver::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    UWorld* World = EntityManager.GetWorld();
+    USplineFollowerPoolSubsystem* Pool = World ? World->GetSubsystem<USplineFollowerPoolSubsystem>() : nullptr;
+    if (!Pool)
+    {
+        return;
+    }
+
+    EntityQuery.ForEachEntityChunk(EntityManager, Context, [Pool](FMassExecutionContext& ChunkContext)
+    {
+        const TArrayView<FSplineFollowerActorFragment> Actors = ChunkContext.GetMutableFragmentView<FSplineFollowerActorFragment>();
+        for (FSplineFollowerActorFragment& ActorFragment : Actors)
+        {
+            if (ASplineFollowerBase* Actor = ActorFragment.Actor.Get())
+            {
+                Pool->ReleaseActor(Actor);
+            }
+            ActorFragment.Actor.Reset();
+        }
+    });
+}
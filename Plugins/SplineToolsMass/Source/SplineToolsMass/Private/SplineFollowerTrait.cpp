@@ -0,0 +1,19 @@
+#include "SplineFollowerTrait.h"
+#include "MassEntityTemplateRegistry.h"
+#include "MassEntityUtils.h"
+#include "MassCommonFragments.h"
+
+void USplineFollowerTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+    BuildContext.AddFragment<FSplineFollowerFragment>();
+    BuildContext.AddFragment<FTransformFragment>();
+    BuildContext.AddTag<FSplineFollowerTag>();
+
+    if (Representation.ActorClass)
+    {
+        FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
+
+        BuildContext.AddFragment<FSplineFollowerActorFragment>();
+        BuildContext.AddConstSharedFragment(EntityManager.GetOrCreateConstSharedFragment(Representation));
+    }
+}
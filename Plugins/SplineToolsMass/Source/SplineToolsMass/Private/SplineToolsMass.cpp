@@ -0,0 +1,17 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SplineToolsMass.h"
+
+#define LOCTEXT_NAMESPACE "FSplineToolsMassModule"
+
+void FSplineToolsMassModule::StartupModule()
+{
+}
+
+void FSplineToolsMassModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+	
+IMPLEMENT_MODULE(FSplineToolsMassModule, SplineToolsMass)
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassEntityTypes.h"
+#include "SplineDistanceTable.h"
+#include "SplineFollowerMassSubsystem.generated.h"
+
+class USplineComponent;
+class UMassEntityConfigAsset;
+
+// Spline data the Mass processors read off the game thread
+struct SPLINETOOLSMASS_API FSplineMassRoute
+{
+    TWeakObjectPtr<USplineComponent> Spline;
+
+    // Spline in the USplineLibrarySubsystem library, whose table is already in world space
+    int32 LibraryIndex = INDEX_NONE;
+
+    TSharedPtr<const FSplineDistanceTable> Table;
+    FTransform ComponentToWorld;
+    float SplineLength = 0.0f;
+
+    // Entities spawned on the route and not destroyed through DestroyFollowers
+    int32 NumEntities = 0;
+};
+
+// Spawns ambient spline followers as Mass entities and keeps the routes they follow
+UCLASS()
+class SPLINETOOLSMASS_API USplineFollowerMassSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // Spawn Count entities of Config spread evenly along Spline, the config needs the Spline Follower trait
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    int32 SpawnFollowers(UMassEntityConfigAsset* Config, USplineComponent* Spline, int32 Count, float Speed);
+
+    int32 SpawnFollowers(UMassEntityConfigAsset* Config, USplineComponent* Spline, int32 Count, float Speed, TArray<FMassEntityHandle>& OutEntities);
+
+    // Spawn Count entities along a spline of the open spline library. They are never materialised as actors,
+    // and stop where they are once another library is opened
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    int32 SpawnLibraryFollowers(UMassEntityConfigAsset* Config, int32 LibrarySplineIndex, int32 Count, float Speed);
+
+    int32 SpawnLibraryFollowers(UMassEntityConfigAsset* Config, int32 LibrarySplineIndex, int32 Count, float Speed, TArray<FMassEntityHandle>& OutEntities);
+
+    void DestroyFollowers(const TArray<FMassEntityHandle>& Entities);
+
+    // Re-read spline transforms and rebuild stale distance tables, game thread only
+    void RefreshRoutes();
+
+    const TArray<FSplineMassRoute>& GetRoutes() const { return Routes; }
+
+    // Distance table settings used for every route
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Properties|Performance")
+    float BakedSampleSpacing = 50.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Properties|Performance")
+    float BakedMaxError = 1.0f;
+
+private:
+    int32 FindOrAddRoute(USplineComponent* Spline);
+    int32 FindOrAddLibraryRoute(int32 LibrarySplineIndex);
+
+    int32 SpawnOnRoute(UMassEntityConfigAsset* Config, int32 RouteIndex, int32 Count, float Speed, TArray<FMassEntityHandle>& OutEntities);
+
+    // Detach routes from the previous library's spline indices
+    void ClearLibraryRoutes();
+
+    TArray<FSplineMassRoute> Routes;
+
+    FDelegateHandle LibraryChangedHandle;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassObserverProcessor.h"
+#include "MassEntityQuery.h"
+#include "SplineFollowerProcessors.generated.h"
+
+// Derives every follower entity's distance from its follow state and samples its route's baked table,
+// chunk by chunk and in parallel across chunks
+UCLASS()
+class SPLINETOOLSMASS_API USplineFollowerMovementProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    USplineFollowerMovementProcessor();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+};
+
+// Materialises pooled follower actors for entities near a viewer and returns them to the pool when they move away
+UCLASS()
+class SPLINETOOLSMASS_API USplineFollowerRepresentationProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    USplineFollowerRepresentationProcessor();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+};
+
+// Returns the actor of a destroyed follower entity to the pool
+UCLASS()
+class SPLINETOOLSMASS_API USplineFollowerActorReleaseObserver : public UMassObserverProcessor
+{
+    GENERATED_BODY()
+
+public:
+    USplineFollowerActorReleaseObserver();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTraitBase.h"
+#include "SplineMassFragments.h"
+#include "SplineFollowerTrait.generated.h"
+
+// Makes an entity an ambient spline follower. With an ActorClass set, entities near a viewer are
+// represented by a pooled follower actor that continues the entity's motion
+UCLASS(meta = (DisplayName = "Spline Follower"))
+class SPLINETOOLSMASS_API USplineFollowerTrait : public UMassEntityTraitBase
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, Category = "Spline Properties")
+    FSplineFollowerRepresentationParams Representation;
+
+protected:
+    virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+};
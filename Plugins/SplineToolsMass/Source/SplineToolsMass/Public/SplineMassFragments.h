@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "SplineFollowState.h"
+#include "SplineMassFragments.generated.h"
+
+class ASplineFollowerBase;
+
+// Motion of one ambient follower, evaluated the same way as a replicated ASplineFollowerBase
+USTRUCT()
+struct SPLINETOOLSMASS_API FSplineFollowerFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    FSplineFollowState State;
+
+    // Route in USplineFollowerMassSubsystem
+    int32 RouteIndex = INDEX_NONE;
+
+    // Distance derived from State this frame
+    float Distance = 0.0f;
+};
+
+// Actor currently materialised for the entity, if any
+USTRUCT()
+struct SPLINETOOLSMASS_API FSplineFollowerActorFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    TWeakObjectPtr<ASplineFollowerBase> Actor;
+};
+
+USTRUCT()
+struct SPLINETOOLSMASS_API FSplineFollowerTag : public FMassTag
+{
+    GENERATED_BODY()
+};
+
+// When to swap an entity for a full follower actor, shared by every entity of a config
+USTRUCT()
+struct SPLINETOOLSMASS_API FSplineFollowerRepresentationParams : public FMassConstSharedFragment
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, Category = "Spline Properties")
+    TSubclassOf<ASplineFollowerBase> ActorClass;
+
+    // Entities closer than this to a viewer get an actor
+    UPROPERTY(EditAnywhere, Category = "Spline Properties", meta = (ClampMin = "0.0"))
+    float MaterializeDistance = 5000.0f;
+
+    // Actors farther than this from every viewer go back to the pool, larger than MaterializeDistance to avoid flicker
+    UPROPERTY(EditAnywhere, Category = "Spline Properties", meta = (ClampMin = "0.0"))
+    float DematerializeDistance = 6000.0f;
+};
@@ -43,6 +43,98 @@ void ASkeletalSplineFollower::BeginPlay()
     Super::BeginPlay();
 
     ActiveMesh = Cast<UMeshComponent>(SkeletalMeshComponent);
+
+    if (bUseAnimationBudgeting)
+    {
+        SkeletalMeshComponent->bEnableUpdateRateOptimizations = true;
+        SkeletalMeshComponent->OnAnimUpdateRateParamsCreated.BindUObject(this, &ASkeletalSplineFollower::ConfigureAnimUpdateRate);
+
+        // Parameters may already exist if the component was registered with optimisations enabled
+        if (SkeletalMeshComponent->AnimUpdateRateParams)
+        {
+            ConfigureAnimUpdateRate(SkeletalMeshComponent->AnimUpdateRateParams);
+        }
+    }
+
+    USplinePoseSharingSubsystem* PoseSharing = GetWorld()->GetSubsystem<USplinePoseSharingSubsystem>();
+    if (PoseSharing && (bUseAnimationBudgeting || bShareLeaderPose))
+    {
+        PoseSharing->TrackPoseEvaluations(SkeletalMeshComponent);
+    }
+
+    JoinPoseGroup();
+}
+
+// EndPlay
+void ASkeletalSplineFollower::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    LeavePoseGroup();
+
+    if (USplinePoseSharingSubsystem* PoseSharing = GetWorld()->GetSubsystem<USplinePoseSharingSubsystem>())
+    {
+        PoseSharing->UntrackPoseEvaluations(SkeletalMeshComponent);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+// A route or adopted spline moves the follower to the group of that path
+void ASkeletalSplineFollower::OnFollowedSplineChanged()
+{
+    Super::OnFollowedSplineChanged();
+
+    if (bInPoseGroup && SplineComponent && USplinePoseSharingSubsystem::MakeGroupKey(SplineComponent, SkeletalMeshComponent) != PoseGroupKey)
+    {
+        LeavePoseGroup();
+        JoinPoseGroup();
+    }
+}
+
+void ASkeletalSplineFollower::OnReleasedToPool()
+{
+    LeavePoseGroup();
+
+    Super::OnReleasedToPool();
+}
+
+void ASkeletalSplineFollower::OnAcquiredFromPool()
+{
+    Super::OnAcquiredFromPool();
+
+    JoinPoseGroup();
+}
+
+void ASkeletalSplineFollower::JoinPoseGroup()
+{
+    USplinePoseSharingSubsystem* PoseSharing = GetWorld()->GetSubsystem<USplinePoseSharingSubsystem>();
+    if (!PoseSharing || !bShareLeaderPose || !SplineComponent || bInPoseGroup)
+    {
+        return;
+    }
+
+    PoseGroupKey = USplinePoseSharingSubsystem::MakeGroupKey(SplineComponent, SkeletalMeshComponent);
+    PoseSharing->RegisterFollower(SkeletalMeshComponent, PoseGroupKey, FollowersPerLeaderPose);
+    bInPoseGroup = true;
+}
+
+void ASkeletalSplineFollower::LeavePoseGroup()
+{
+    if (!bInPoseGroup)
+    {
+        return;
+    }
+
+    if (USplinePoseSharingSubsystem* PoseSharing = GetWorld()->GetSubsystem<USplinePoseSharingSubsystem>())
+    {
+        PoseSharing->UnregisterFollower(SkeletalMeshComponent, PoseGroupKey);
+    }
+    bInPoseGroup = false;
+}
+
+void ASkeletalSplineFollower::ConfigureAnimUpdateRate(FAnimUpdateRateParameters* UpdateRateParams)
+{
+    UpdateRateParams->BaseNonRenderedUpdateRate = NonRenderedUpdateRate;
+    UpdateRateParams->BaseVisibleDistanceFactorThesholds = VisibleDistanceFactorThresholds;
 }
 
 // Tick
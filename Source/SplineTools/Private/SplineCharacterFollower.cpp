@@ -1,15 +1,21 @@
 #include "SplineCharacterFollower.h"
 #include "Engine/World.h"
+#include "SplineFollowerSubsystem.h"
+#include "SplineMovementComponent.h"
+#include "SplineFollowerPoolSubsystem.h"
+#include "SplineCurveCopy.h"
+#include "Net/Core/PushModel/PushModel.h"
 #if WITH_EDITOR
 #include "SplineManagerTool.h"
 #endif
 
-ASplineCharacterFollower::ASplineCharacterFollower()
+ASplineCharacterFollower::ASplineCharacterFollower(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer.SetDefaultSubobjectClass<USplineMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
     PrimaryActorTick.bCanEverTick = true;
 
     bReplicates = true;
-    bIsFollowing = true;
+    FollowState.bIsFollowing = true;
 
     CurrentSplinePosition = 0.0f;
     MovementSpeed = 100.0f;
@@ -39,28 +45,32 @@ void ASplineCharacterFollower::BeginPlay()
     Super::BeginPlay();
     SplineComponent->SetHiddenInGame(true);
 
+    if (USplineMovementComponent* SplineMovement = Cast<USplineMovementComponent>(GetCharacterMovement()))
+    {
+        SplineMovement->SetOnRails(bMoveOnRails);
+    }
+
     CreateAndFollowNewSpline();
 
     if (SplineComponent)
     {
-        // Generate a random starting position along the spline
-        const float SplineLength = SplineComponent->GetSplineLength();
-        if (bFollowSplineAtRandomPosition) {
-            CurrentSplinePosition = FMath::FRandRange(0.0f, SplineLength);
-        }
-        else {
-            // Clamp the StartFollowingSplineAt variable to be between 0 and 1
-            StartFollowingSplineAt = FMath::Clamp(StartFollowingSplineAt, 0.0f, 1.0f);
-
-            // Calculate the position based on the clamped StartFollowingSplineAt
-            CurrentSplinePosition = StartFollowingSplineAt * SplineLength;
+        ResetStartPosition();
 
+        // Anchor the replicated follow state at the start position, clients take it from the server
+        if (HasAuthority())
+        {
+            RebaseFollowState(FollowState.bIsFollowing);
+        }
+        else
+        {
+            UpdateSplinePositionFromState();
         }
 
         // Move actor to the random position
-        FVector StartLocation = SplineComponent->GetLocationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
-        FRotator StartRotation = SplineComponent->GetRotationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
-        SetActorLocationAndRotation(StartLocation, StartRotation);
+        FVector StartLocation;
+        FRotator StartRotation;
+        EvaluateSplineAtDistance(CurrentSplinePosition, StartLocation, StartRotation);
+        MoveCharacterTo(StartLocation, StartRotation, 0.0f, ETeleportType::TeleportPhysics);
     }
 
     // Begin following the spline if necessary
@@ -68,6 +78,85 @@ void ASplineCharacterFollower::BeginPlay()
     {
         StartFollowingSpline();
     }
+
+    // The follow state is deterministic between changes, nothing has to be sent while it stays the same
+    if (HasAuthority() && bUseNetDormancy)
+    {
+        SetNetDormancy(DORM_DormantAll);
+    }
+
+    // Hand the per-frame update over to the batched subsystem
+    if (bUseBatchedUpdate)
+    {
+        if (USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>())
+        {
+            FollowerSubsystem->RegisterFollower(this);
+            SetActorTickEnabled(false);
+        }
+    }
+}
+
+// Pick the start distance from the random or fixed start settings
+void ASplineCharacterFollower::ResetStartPosition()
+{
+    if (!SplineComponent) return;
+
+    // Generate a random starting position along the spline
+    const float SplineLength = SplineComponent->GetSplineLength();
+
+    if (bFollowSplineAtRandomPosition) {
+        CurrentSplinePosition = FMath::FRandRange(0.0f, SplineLength);
+    }
+    else {
+        // Clamp the StartFollowingSplineAt variable to be between 0 and 1
+        StartFollowingSplineAt = FMath::Clamp(StartFollowingSplineAt, 0.0f, 1.0f);
+
+        // Calculate the position based on the clamped StartFollowingSplineAt
+        CurrentSplinePosition = StartFollowingSplineAt * SplineLength;
+    }
+}
+
+// Park the character in a pool, hidden and without any per-frame work
+void ASplineCharacterFollower::OnReleasedToPool()
+{
+    StopFollowingSpline();
+    ParkInPool(*this);
+}
+
+// Reset the spline position and state as if the character was just spawned, the route is kept
+void ASplineCharacterFollower::OnAcquiredFromPool()
+{
+    SplineCursor.Reset();
+    ResetStartPosition();
+
+    if (HasAuthority())
+    {
+        RebaseFollowState(bStartFollowOnBeginPlay);
+    }
+
+    if (SplineComponent)
+    {
+        FVector StartLocation;
+        FRotator StartRotation;
+        EvaluateSplineAtDistance(CurrentSplinePosition, StartLocation, StartRotation);
+        MoveCharacterTo(StartLocation, StartRotation, 0.0f, ETeleportType::TeleportPhysics);
+    }
+
+    UnparkFromPool(*this, bUseBatchedUpdate);
+}
+
+void ASplineCharacterFollower::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>())
+    {
+        FollowerSubsystem->UnregisterFollower(this);
+        FollowerSubsystem->ReleaseSharedRoute(SharedRoute);
+        SharedRoute = nullptr;
+    }
+
+    ReleaseSpawnedSplineActor();
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void ASplineCharacterFollower::BeginDestroy()
@@ -79,7 +168,7 @@ void ASplineCharacterFollower::BeginDestroy()
         SpawnedSplineActor->Destroy();
         SpawnedSplineActor = nullptr;  // Clear the reference
     }
-    else
+    else if (!bShareRoute)
     {
         UE_LOG(LogTemp, Warning, TEXT("SplineTrackerActor was already destroyed or not spawned."));
     }
@@ -91,7 +180,7 @@ void ASplineCharacterFollower::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
-    if (bIsFollowing)
+    if (FollowState.bIsFollowing && ConsumeLODFrame(DeltaTime))
     {
         if (HasAuthority())
         {
@@ -121,20 +210,77 @@ void ASplineCharacterFollower::InitializeSplineManager()
 
 void ASplineCharacterFollower::StartFollowingSpline()
 {
-    if (SplineComponent)
+    if (SplineComponent && HasAuthority())
     {
-        bIsFollowing = true;
+        UpdateSplinePositionFromState();
+        RebaseFollowState(true);
     }
 }
 
 void ASplineCharacterFollower::StopFollowingSpline()
 {
-    bIsFollowing = false;
+    if (HasAuthority())
+    {
+        UpdateSplinePositionFromState();
+        RebaseFollowState(false);
+    }
 }
 
 void ASplineCharacterFollower::SetSplineComponent(USplineComponent* Spline)
 {
     SplineComponent = Spline;
+    SplineCursor.Reset();
+    DistanceTable.Reset();
+    RefreshBatchedState();
+}
+
+void ASplineCharacterFollower::SetMovementSpeed(float NewMovementSpeed)
+{
+    MovementSpeed = NewMovementSpeed;
+
+    if (HasAuthority())
+    {
+        UpdateSplinePositionFromState();
+        RebaseFollowState(FollowState.bIsFollowing);
+    }
+}
+
+// Restart the deterministic follow state from the current distance and server time
+void ASplineCharacterFollower::RebaseFollowState(bool bFollowing)
+{
+    // Dormant followers replicate the new state once and go back to sleep
+    if (bUseNetDormancy && NetDormancy > DORM_Awake)
+    {
+        FlushNetDormancy();
+    }
+
+    const float SplineLength = SplineComponent ? SplineComponent->GetSplineLength() : 0.0f;
+    FollowState.StartDistance.Set(CurrentSplinePosition, SplineLength, DistanceQuantizationBits);
+    FollowState.StartServerTime = FSplineFollowState::GetServerTime(GetWorld());
+    FollowState.Speed = MovementSpeed;
+    FollowState.bIsFollowing = bFollowing;
+    MARK_PROPERTY_DIRTY_FROM_NAME(ASplineCharacterFollower, FollowState, this);
+
+    RefreshBatchedState();
+}
+
+// Only used when not batched, the subsystem applies the same bands to batched followers
+bool ASplineCharacterFollower::ConsumeLODFrame(float& DeltaTime)
+{
+    return !LODSettings.bEnabled || LODTicker.ConsumeFrame(*this, LODSettings, GetSplineRelevancyLocation(), DeltaTime);
+}
+
+void ASplineCharacterFollower::RefreshBatchedState()
+{
+    if (GetSplineBatchHandle() == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>())
+    {
+        FollowerSubsystem->RefreshFollower(this);
+    }
 }
 
 void ASplineCharacterFollower::CreateAndFollowNewSpline()
@@ -145,20 +291,28 @@ void ASplineCharacterFollower::CreateAndFollowNewSpline()
         return;
     }
 
+    if (bShareRoute)
+    {
+        FollowSharedRoute();
+        return;
+    }
+
     if (!SplineActorClass)
     {
         UE_LOG(LogTemp, Warning, TEXT("SplineActorClass is not set."));
         return;
     }
 
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.Owner = this;
-    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    ReleaseSpawnedSplineActor();
 
-    UWorld* World = GetWorld();
-    if (World)
+    // Trackers come from the pool, it only spawns when no tracker of this class is parked
+    if (USplineFollowerPoolSubsystem* Pool = GetWorld()->GetSubsystem<USplineFollowerPoolSubsystem>())
     {
-        SpawnedSplineActor = GetWorld()->SpawnActor<ASplineTrackerActor>(SplineActorClass, GetActorLocation(), GetActorRotation(), SpawnParams);
+        SpawnedSplineActor = Pool->Acquire<ASplineTrackerActor>(SplineActorClass, GetActorTransform());
+        if (SpawnedSplineActor)
+        {
+            SpawnedSplineActor->SetOwner(this);
+        }
     }
 
     if (!SpawnedSplineActor)
@@ -174,54 +328,151 @@ void ASplineCharacterFollower::CreateAndFollowNewSpline()
         return;
     }
 
-    NewSpline->ClearSplinePoints();
-    const int32 NumPoints = SplineComponent->GetNumberOfSplinePoints();
-    const bool bIsLoop = SplineComponent->IsClosedLoop();
+    // Same world placement as the character's spline, so the curves and their reparam table copy as they are
+    NewSpline->SetWorldTransform(SplineComponent->GetComponentTransform());
+    FSplineCurveCopy::Copy(*SplineComponent, *NewSpline);
+
+    SetSplineComponent(NewSpline);
+    StartFollowingSpline();
+}
 
-    for (int32 i = 0; i < NumPoints; i++)
+// Hand the spawned tracker back to the pool
+void ASplineCharacterFollower::ReleaseSpawnedSplineActor()
+{
+    if (!SpawnedSplineActor)
     {
-        FVector Location = SplineComponent->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World);
+        return;
+    }
 
-        NewSpline->AddSplinePoint(Location, ESplineCoordinateSpace::World, true);
+    if (USplineFollowerPoolSubsystem* Pool = GetWorld()->GetSubsystem<USplineFollowerPoolSubsystem>())
+    {
+        Pool->ReleaseActor(SpawnedSplineActor);
+        SpawnedSplineActor = nullptr;
     }
+}
 
-    NewSpline->SetClosedLoop(bIsLoop);
-    NewSpline->UpdateSpline();
+// Follow the shared route with the points of the current spline, without spawning anything
+void ASplineCharacterFollower::FollowSharedRoute()
+{
+    USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>();
+    if (!FollowerSubsystem)
+    {
+        return;
+    }
 
-    SetSplineComponent(NewSpline);
+    USplineComponent* PreviousSpline = SplineComponent;
+    USplineComponent* Route = FollowerSubsystem->AcquireSharedRoute(PreviousSpline);
+    if (!Route)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to acquire a shared spline route."));
+        return;
+    }
+
+    // Acquire before releasing so following the same route again keeps it alive
+    FollowerSubsystem->ReleaseSharedRoute(SharedRoute);
+    SharedRoute = Route;
+
+    // The authored spline only describes the route, drop it once the route exists
+    if (PreviousSpline && PreviousSpline != Route && PreviousSpline->GetOwner() == this)
+    {
+        PreviousSpline->DestroyComponent();
+    }
+
+    SetSplineComponent(Route);
     StartFollowingSpline();
 }
 
+USplineComponent* ASplineCharacterFollower::MakeSplineUnique()
+{
+    USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>();
+    if (!SharedRoute || !FollowerSubsystem)
+    {
+        return SplineComponent;
+    }
+
+    SharedRoute = FollowerSubsystem->MakeRouteUnique(SharedRoute);
+    SetSplineComponent(SharedRoute);
+    return SharedRoute;
+}
+
 void ASplineCharacterFollower::UpdateSplinePosition(float DeltaTime)
 {
     if (!SplineComponent) return;
 
-    CurrentSplinePosition += MovementSpeed * DeltaTime;
-    if (CurrentSplinePosition > SplineComponent->GetSplineLength())
-    {
-        CurrentSplinePosition = 0.0f;
-    }
+    UpdateSplinePositionFromState();
 
-    FVector NewLocation = SplineComponent->GetLocationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
-    FRotator NewRotation = SplineComponent->GetRotationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
+    FVector NewLocation;
+    FRotator NewRotation;
+    EvaluateSplineAtDistance(CurrentSplinePosition, NewLocation, NewRotation);
 
-    SetActorLocationAndRotation(NewLocation, NewRotation);
+    MoveCharacterTo(NewLocation, NewRotation, DeltaTime, ETeleportType::None);
 }
 
 void ASplineCharacterFollower::PredictClientMovement(float DeltaTime)
 {
     if (!SplineComponent) return;
 
-    CurrentSplinePosition += MovementSpeed * DeltaTime;
-    if (CurrentSplinePosition > SplineComponent->GetSplineLength())
+    UpdateSplinePositionFromState();
+
+    FVector PredictedLocation;
+    FRotator PredictedRotation;
+    EvaluateSplineAtDistance(CurrentSplinePosition, PredictedLocation, PredictedRotation);
+
+    InterpolateMovement(PredictedLocation, PredictedRotation, DeltaTime);
+}
+
+void ASplineCharacterFollower::UpdateSplinePositionFromState()
+{
+    if (!SplineComponent) return;
+
+    CurrentSplinePosition = FollowState.GetDistanceAtTime(FSplineFollowState::GetServerTime(GetWorld()), SplineComponent->GetSplineLength());
+}
+
+// Called by the batched subsystem with the already advanced distance and its evaluated transform
+void ASplineCharacterFollower::ApplySplineTransform(float NewSplinePosition, const FVector& Location, const FRotator& Rotation, float DeltaTime)
+{
+    CurrentSplinePosition = NewSplinePosition;
+
+    if (HasAuthority())
+    {
+        MoveCharacterTo(Location, Rotation, DeltaTime, ETeleportType::None);
+    }
+    else
+    {
+        InterpolateMovement(Location, Rotation, DeltaTime);
+    }
+}
+
+// Shared baked table for the followed spline, refreshed when the spline changed
+TSharedPtr<const FSplineDistanceTable> ASplineCharacterFollower::GetDistanceTable()
+{
+    if (!bUseBakedDistanceTable || !SplineComponent)
+    {
+        return nullptr;
+    }
+
+    if (!DistanceTable.IsValid() || !DistanceTable->IsUpToDate(*SplineComponent))
     {
-        CurrentSplinePosition = 0.0f;
+        if (USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>())
+        {
+            DistanceTable = FollowerSubsystem->FindOrBuildDistanceTable(SplineComponent, BakedSampleSpacing, BakedMaxError);
+        }
     }
 
-    FVector PredictedLocation = SplineComponent->GetLocationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
-    FRotator PredictedRotation = SplineComponent->GetRotationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
+    return DistanceTable;
+}
 
-    InterpolateMovement(PredictedLocation, PredictedRotation, DeltaTime);
+// Evaluate the followed spline in world space, through the baked distance table when enabled
+// or else through the incremental reparam cursor
+void ASplineCharacterFollower::EvaluateSplineAtDistance(float Distance, FVector& OutLocation, FRotator& OutRotation)
+{
+    if (const TSharedPtr<const FSplineDistanceTable> Table = GetDistanceTable())
+    {
+        Table->SampleWorld(Distance, SplineComponent->GetComponentTransform(), OutLocation, OutRotation);
+        return;
+    }
+
+    SplineCursor.EvaluateWorld(*SplineComponent, Distance, OutLocation, OutRotation);
 }
 
 void ASplineCharacterFollower::InterpolateMovement(FVector TargetLocation, FRotator TargetRotation, float DeltaTime)
@@ -229,24 +480,54 @@ void ASplineCharacterFollower::InterpolateMovement(FVector TargetLocation, FRota
     FVector SmoothedLocation = FMath::VInterpTo(GetActorLocation(), TargetLocation, DeltaTime, InterpolationSpeed);
     FQuat SmoothedRotation = FQuat::Slerp(GetActorQuat(), FQuat(TargetRotation), DeltaTime * InterpolationSpeed);
 
-    SetActorLocation(SmoothedLocation);
-    SetActorRotation(SmoothedRotation);
+    MoveCharacterTo(SmoothedLocation, SmoothedRotation.Rotator(), DeltaTime, ETeleportType::None);
+}
+
+void ASplineCharacterFollower::MoveCharacterTo(const FVector& NewLocation, const FRotator& NewRotation, float DeltaTime, ETeleportType Teleport)
+{
+    USplineMovementComponent* SplineMovement = Cast<USplineMovementComponent>(GetCharacterMovement());
+    if (SplineMovement && SplineMovement->IsOnRails())
+    {
+        SplineMovement->MoveAlongSpline(NewLocation, NewRotation.Quaternion(), DeltaTime, Teleport);
+        return;
+    }
+
+    SetActorLocationAndRotation(NewLocation, NewRotation, false, nullptr, Teleport);
 }
 
-void ASplineCharacterFollower::OnRep_CurrentSplinePosition()
+void ASplineCharacterFollower::OnRep_FollowState()
 {
+    RefreshBatchedState();
+
     if (!SplineComponent) return;
 
-    FVector NewLocation = SplineComponent->GetLocationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
-    FRotator NewRotation = SplineComponent->GetRotationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
+    UpdateSplinePositionFromState();
+
+    FVector NewLocation;
+    FRotator NewRotation;
+    EvaluateSplineAtDistance(CurrentSplinePosition, NewLocation, NewRotation);
+
+    MoveCharacterTo(NewLocation, NewRotation, 0.0f, ETeleportType::TeleportPhysics);
+}
 
-    SetActorLocationAndRotation(NewLocation, NewRotation);
+// Distance culling against the position on the spline, which is known without moving any component
+bool ASplineCharacterFollower::IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const
+{
+    const TOptional<bool> bSplineRelevant = IsSplineNetRelevantFor(*this, bUseSplineRelevancy, RealViewer, ViewTarget, SrcLocation, DistanceTable.Get());
+    return bSplineRelevant.IsSet() ? bSplineRelevant.GetValue() : Super::IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation);
+}
+
+FVector ASplineCharacterFollower::GetSplineRelevancyLocation() const
+{
+    return ComputeSplineRelevancyLocation(*this, DistanceTable.Get());
 }
 
 void ASplineCharacterFollower::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    DOREPLIFETIME(ASplineCharacterFollower, CurrentSplinePosition);
-    DOREPLIFETIME(ASplineCharacterFollower, bIsFollowing);
+    // Push based, the state is only compared after RebaseFollowState marked it dirty
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+    DOREPLIFETIME_WITH_PARAMS_FAST(ASplineCharacterFollower, FollowState, Params);
 }
\ No newline at end of file
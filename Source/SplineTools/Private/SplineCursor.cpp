@@ -0,0 +1,78 @@
+#include "SplineCursor.h"
+#include "Components/SplineComponent.h"
+
+// Jumps further than this many reparam entries are treated as teleports and use a full search
+static constexpr int32 MaxCursorSteps = 16;
+
+float FSplineCursor::GetInputKeyAtDistance(const USplineComponent& Spline, float Distance)
+{
+    const TArray<FInterpCurvePoint<float>>& Points = Spline.SplineCurves.ReparamTable.Points;
+    const int32 NumPoints = Points.Num();
+
+    if (NumPoints < 2)
+    {
+        return NumPoints == 1 ? Points[0].OutVal : 0.0f;
+    }
+
+    // Full search after spline edits, wrap-around or any backwards move
+    if (ReparamIndex == INDEX_NONE || SplineVersion != Spline.SplineCurves.Version || Distance < LastDistance || ReparamIndex >= NumPoints - 1)
+    {
+        ReparamIndex = FindReparamIndex(Spline, Distance);
+        SplineVersion = Spline.SplineCurves.Version;
+    }
+    else
+    {
+        int32 Steps = 0;
+        while (ReparamIndex < NumPoints - 2 && Points[ReparamIndex + 1].InVal <= Distance)
+        {
+            ++ReparamIndex;
+
+            if (++Steps > MaxCursorSteps)
+            {
+                ReparamIndex = FindReparamIndex(Spline, Distance);
+                break;
+            }
+        }
+    }
+
+    LastDistance = Distance;
+
+    // The reparam table is linear, matching FInterpCurve evaluation
+    const FInterpCurvePoint<float>& Start = Points[ReparamIndex];
+    const FInterpCurvePoint<float>& End = Points[ReparamIndex + 1];
+    const float Range = End.InVal - Start.InVal;
+    const float Alpha = Range > KINDA_SMALL_NUMBER ? FMath::Clamp((Distance - Start.InVal) / Range, 0.0f, 1.0f) : 0.0f;
+
+    return FMath::Lerp(Start.OutVal, End.OutVal, Alpha);
+}
+
+int32 FSplineCursor::FindReparamIndex(const USplineComponent& Spline, float Distance) const
+{
+    const TArray<FInterpCurvePoint<float>>& Points = Spline.SplineCurves.ReparamTable.Points;
+
+    // Last entry whose distance is not past the requested one
+    int32 Low = 0;
+    int32 High = Points.Num() - 2;
+    while (Low < High)
+    {
+        const int32 Middle = (Low + High + 1) / 2;
+        if (Points[Middle].InVal <= Distance)
+        {
+            Low = Middle;
+        }
+        else
+        {
+            High = Middle - 1;
+        }
+    }
+
+    return Low;
+}
+
+void FSplineCursor::EvaluateWorld(const USplineComponent& Spline, float Distance, FVector& OutLocation, FRotator& OutRotation)
+{
+    const float InputKey = GetInputKeyAtDistance(Spline, Distance);
+
+    OutLocation = Spline.GetLocationAtSplineInputKey(InputKey, ESplineCoordinateSpace::World);
+    OutRotation = Spline.GetRotationAtSplineInputKey(InputKey, ESplineCoordinateSpace::World);
+}
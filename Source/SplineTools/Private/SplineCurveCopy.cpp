@@ -0,0 +1,80 @@
+#include "SplineCurveCopy.h"
+
+FSplineCurveBakeSettings::FSplineCurveBakeSettings(const USplineComponent& Spline)
+    : bClosedLoop(Spline.IsClosedLoop())
+    , bStationaryEndpoints(Spline.bStationaryEndpoints)
+    , ReparamStepsPerSegment(Spline.ReparamStepsPerSegment)
+    , Scale3D(Spline.GetComponentTransform().GetScale3D())
+{
+}
+
+bool FSplineCurveBakeSettings::operator==(const FSplineCurveBakeSettings& Other) const
+{
+    return bClosedLoop == Other.bClosedLoop
+        && bStationaryEndpoints == Other.bStationaryEndpoints
+        && ReparamStepsPerSegment == Other.ReparamStepsPerSegment
+        && Scale3D.Equals(Other.Scale3D);
+}
+
+void FSplineCurveCopy::CopyCurves(const FSplineCurves& Source, const FSplineCurveBakeSettings& SourceSettings,
+    FSplineCurves& Target, const FSplineCurveBakeSettings& TargetSettings, bool bReuseReparamTable)
+{
+    Target = Source;
+
+    if (!bReuseReparamTable || !(SourceSettings == TargetSettings))
+    {
+        // Also sets the loop keys and auto tangents for the target settings. Loop position overrides are
+        // private to the component, they only survive through a reused table
+        Target.UpdateSpline(TargetSettings.bClosedLoop, TargetSettings.bStationaryEndpoints,
+            TargetSettings.ReparamStepsPerSegment, false, 0.0f, TargetSettings.Scale3D);
+    }
+}
+
+void FSplineCurveCopy::AssignCurves(USplineComponent& Target, FSplineCurves&& Curves)
+{
+    // The copied version belongs to another spline and could match the one cached tables were built from
+    const uint32 Version = Target.SplineCurves.Version + 1;
+
+    Target.SplineCurves = MoveTemp(Curves);
+    Target.SplineCurves.Version = Version;
+    Target.bSplineHasBeenEdited = true;
+    Target.MarkRenderStateDirty();
+}
+
+void FSplineCurveCopy::Copy(const USplineComponent& Source, USplineComponent& Target, bool bReuseReparamTable)
+{
+    Target.bStationaryEndpoints = Source.bStationaryEndpoints;
+    Target.ReparamStepsPerSegment = Source.ReparamStepsPerSegment;
+    Target.SetClosedLoop(Source.IsClosedLoop(), false);
+
+    FSplineCurves Curves;
+    CopyCurves(Source.SplineCurves, FSplineCurveBakeSettings(Source), Curves, FSplineCurveBakeSettings(Target), bReuseReparamTable);
+    AssignCurves(Target, MoveTemp(Curves));
+}
+
+uint32 FSplineCurveCopy::HashCurves(const FSplineCurves& Curves)
+{
+    uint32 Hash = HashCombine(GetTypeHash(Curves.Position.Points.Num()), GetTypeHash(Curves.Position.bIsLooped));
+
+    // Field by field, the curve points have padding
+    for (const FInterpCurvePoint<FVector>& Point : Curves.Position.Points)
+    {
+        Hash = HashCombine(Hash, GetTypeHash(Point.InVal));
+        Hash = HashCombine(Hash, GetTypeHash(Point.OutVal));
+        Hash = HashCombine(Hash, GetTypeHash(Point.ArriveTangent));
+        Hash = HashCombine(Hash, GetTypeHash(Point.LeaveTangent));
+        Hash = HashCombine(Hash, GetTypeHash(Point.InterpMode.GetValue()));
+    }
+
+    for (const FInterpCurvePoint<FQuat>& Point : Curves.Rotation.Points)
+    {
+        Hash = HashCombine(Hash, GetTypeHash(Point.OutVal));
+    }
+
+    for (const FInterpCurvePoint<FVector>& Point : Curves.Scale.Points)
+    {
+        Hash = HashCombine(Hash, GetTypeHash(Point.OutVal));
+    }
+
+    return Hash;
+}
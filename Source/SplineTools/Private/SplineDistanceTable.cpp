@@ -0,0 +1,164 @@
+#include "SplineDistanceTable.h"
+#include "Components/SplineComponent.h"
+#include "SplinePackedCurve.h"
+
+// Upper bound on samples per spline to keep very long splines with tight error bounds in check
+static constexpr int32 MaxDistanceTableSamples = 1 << 20;
+
+void FSplineDistanceTable::Build(const USplineComponent& Spline, float InSampleSpacing, float MaxError, float MinSampleSpacing)
+{
+    SplineLength = Spline.GetSplineLength();
+    SourceSpline = &Spline;
+    SplineVersion = Spline.SplineCurves.Version;
+    NumSplinePoints = Spline.GetNumberOfSplinePoints();
+    bClosedLoop = Spline.IsClosedLoop();
+
+    MinSampleSpacing = FMath::Max(MinSampleSpacing, KINDA_SMALL_NUMBER);
+    float Spacing = FMath::Max(InSampleSpacing, MinSampleSpacing);
+
+    // Every bake and error pass evaluates all of its locations at once through the packed curve's batch kernel
+    FSplinePackedCurve Curve;
+    Curve.Build(Spline);
+    const FSplinePackedCurve* PackedCurve = Curve.IsValid() ? &Curve : nullptr;
+
+    while (true)
+    {
+        const int32 NumSamples = FMath::Clamp(FMath::CeilToInt(SplineLength / Spacing) + 1, 2, MaxDistanceTableSamples);
+        BakeSamples(Spline, PackedCurve, NumSamples);
+
+        if (Spacing <= MinSampleSpacing || NumSamples == MaxDistanceTableSamples || MeasureMaxError(Spline, PackedCurve) <= MaxError)
+        {
+            break;
+        }
+
+        Spacing = FMath::Max(Spacing * 0.5f, MinSampleSpacing);
+    }
+}
+
+void FSplineDistanceTable::InitFromSamples(TConstArrayView<FVector3f> InLocations, TConstArrayView<FQuat4f> InRotations, float InSplineLength)
+{
+    check(InLocations.Num() == InRotations.Num());
+
+    SplineLength = InSplineLength;
+    SourceSpline = TObjectKey<USplineComponent>();
+    SplineVersion = 0;
+    NumSplinePoints = 0;
+    bClosedLoop = false;
+
+    const int32 NumSamples = InLocations.Num();
+    SampleSpacing = NumSamples > 1 ? SplineLength / (NumSamples - 1) : 0.0f;
+    InvSampleSpacing = SampleSpacing > KINDA_SMALL_NUMBER ? 1.0f / SampleSpacing : 0.0f;
+
+    Locations.SetNumUninitialized(NumSamples);
+    Rotations.SetNumUninitialized(NumSamples);
+
+    for (int32 i = 0; i < NumSamples; ++i)
+    {
+        Locations[i] = FVector(InLocations[i]);
+        Rotations[i] = FQuat(InRotations[i]);
+    }
+}
+
+void FSplineDistanceTable::BakeSamples(const USplineComponent& Spline, const FSplinePackedCurve* PackedCurve, int32 NumSamples)
+{
+    // Stretch the spacing slightly so the last sample lands exactly on the spline end
+    SampleSpacing = SplineLength / (NumSamples - 1);
+    InvSampleSpacing = SampleSpacing > KINDA_SMALL_NUMBER ? 1.0f / SampleSpacing : 0.0f;
+
+    Locations.SetNumUninitialized(NumSamples);
+    Rotations.SetNumUninitialized(NumSamples);
+
+    if (PackedCurve)
+    {
+        TArray<float> Distances;
+        TArray<FVector> Tangents;
+        Distances.SetNumUninitialized(NumSamples);
+        Tangents.SetNumUninitialized(NumSamples);
+
+        for (int32 i = 0; i < NumSamples; ++i)
+        {
+            Distances[i] = i * SampleSpacing;
+        }
+
+        PackedCurve->EvaluateBatch(Distances, Locations, Tangents);
+    }
+
+    for (int32 i = 0; i < NumSamples; ++i)
+    {
+        const float Distance = i * SampleSpacing;
+        if (!PackedCurve)
+        {
+            Locations[i] = Spline.GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local);
+        }
+        Rotations[i] = Spline.GetQuaternionAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local);
+    }
+}
+
+float FSplineDistanceTable::MeasureMaxError(const USplineComponent& Spline, const FSplinePackedCurve* PackedCurve) const
+{
+    const int32 NumIntervals = Locations.Num() - 1;
+
+    // Linear interpolation error is largest around the middle of each interval
+    TArray<FVector> Exact;
+    Exact.SetNumUninitialized(NumIntervals);
+
+    if (PackedCurve)
+    {
+        TArray<float> Distances;
+        TArray<FVector> Tangents;
+        Distances.SetNumUninitialized(NumIntervals);
+        Tangents.SetNumUninitialized(NumIntervals);
+
+        for (int32 i = 0; i < NumIntervals; ++i)
+        {
+            Distances[i] = (i + 0.5f) * SampleSpacing;
+        }
+
+        PackedCurve->EvaluateBatch(Distances, Exact, Tangents);
+    }
+    else
+    {
+        for (int32 i = 0; i < NumIntervals; ++i)
+        {
+            Exact[i] = Spline.GetLocationAtDistanceAlongSpline((i + 0.5f) * SampleSpacing, ESplineCoordinateSpace::Local);
+        }
+    }
+
+    float MaxErrorFound = 0.0f;
+    for (int32 i = 0; i < NumIntervals; ++i)
+    {
+        const FVector Approximated = FMath::Lerp(Locations[i], Locations[i + 1], 0.5f);
+        MaxErrorFound = FMath::Max(MaxErrorFound, FVector::Dist(Exact[i], Approximated));
+    }
+
+    return MaxErrorFound;
+}
+
+bool FSplineDistanceTable::IsUpToDate(const USplineComponent& Spline) const
+{
+    return IsValid()
+        && SourceSpline == TObjectKey<USplineComponent>(&Spline)
+        && SplineVersion == Spline.SplineCurves.Version
+        && NumSplinePoints == Spline.GetNumberOfSplinePoints()
+        && bClosedLoop == Spline.IsClosedLoop();
+}
+
+void FSplineDistanceTable::Sample(float Distance, FVector& OutLocation, FQuat& OutRotation) const
+{
+    const float Position = FMath::Clamp(Distance, 0.0f, SplineLength) * InvSampleSpacing;
+    const int32 Index = FMath::Min(FMath::FloorToInt(Position), Locations.Num() - 2);
+    const float Alpha = Position - Index;
+
+    OutLocation = FMath::Lerp(Locations[Index], Locations[Index + 1], Alpha);
+    OutRotation = FQuat::FastLerp(Rotations[Index], Rotations[Index + 1], Alpha).GetNormalized();
+}
+
+void FSplineDistanceTable::SampleWorld(float Distance, const FTransform& ComponentToWorld, FVector& OutLocation, FRotator& OutRotation) const
+{
+    FVector LocalLocation;
+    FQuat LocalRotation;
+    Sample(Distance, LocalLocation, LocalRotation);
+
+    OutLocation = ComponentToWorld.TransformPosition(LocalLocation);
+    OutRotation = ComponentToWorld.TransformRotation(LocalRotation).Rotator();
+}
@@ -0,0 +1,82 @@
+#include "SplineFollowState.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+
+void FSplineQuantizedDistance::Set(float Distance, float SplineLength, uint8 InNumBits)
+{
+    NumBits = FMath::Clamp<uint8>(InNumBits, MinBits, MaxBits);
+
+    if (SplineLength <= KINDA_SMALL_NUMBER)
+    {
+        Alpha = 0.0f;
+        return;
+    }
+
+    // Round here so the server keeps exactly the value clients decode
+    const uint32 MaxValue = GetMaxQuantizedValue(NumBits);
+    const float Normalized = FMath::Clamp(Distance / SplineLength, 0.0f, 1.0f);
+    const uint32 Quantized = static_cast<uint32>(FMath::RoundToInt(Normalized * MaxValue));
+    Alpha = static_cast<float>(static_cast<double>(Quantized) / MaxValue);
+}
+
+bool FSplineQuantizedDistance::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    // The precision travels with the value, 5 bits are enough for up to 24 bits
+    uint32 Bits = NumBits;
+    Ar.SerializeBits(&Bits, 5);
+
+    Bits = FMath::Clamp<uint32>(Bits, MinBits, MaxBits);
+    const uint32 MaxValue = GetMaxQuantizedValue(static_cast<uint8>(Bits));
+
+    uint32 Quantized = 0;
+    if (Ar.IsSaving())
+    {
+        Quantized = static_cast<uint32>(FMath::RoundToInt(FMath::Clamp(Alpha, 0.0f, 1.0f) * MaxValue));
+    }
+
+    Ar.SerializeBits(&Quantized, Bits);
+
+    if (Ar.IsLoading())
+    {
+        NumBits = static_cast<uint8>(Bits);
+        Alpha = static_cast<float>(static_cast<double>(FMath::Min(Quantized, MaxValue)) / MaxValue);
+    }
+
+    bOutSuccess = true;
+    return true;
+}
+
+float FSplineFollowState::EvaluateDistance(float StartDistance, double StartServerTime, float Speed, double ServerTime, float SplineLength, bool bLoop)
+{
+    const double Distance = StartDistance + Speed * FMath::Max(ServerTime - StartServerTime, 0.0);
+
+    if (SplineLength <= KINDA_SMALL_NUMBER)
+    {
+        return StartDistance;
+    }
+
+    if (!bLoop)
+    {
+        return static_cast<float>(FMath::Clamp(Distance, 0.0, static_cast<double>(SplineLength)));
+    }
+
+    // Evaluate in double so followers stay precise long after they started
+    double Wrapped = FMath::Fmod(Distance, static_cast<double>(SplineLength));
+    if (Wrapped < 0.0)
+    {
+        Wrapped += SplineLength;
+    }
+
+    return static_cast<float>(Wrapped);
+}
+
+double FSplineFollowState::GetServerTime(const UWorld* World)
+{
+    if (!World)
+    {
+        return 0.0;
+    }
+
+    const AGameStateBase* GameState = World->GetGameState();
+    return GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+}
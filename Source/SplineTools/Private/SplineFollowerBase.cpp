@@ -2,11 +2,19 @@
 #include "Components/SplineComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "SplineFollowerSubsystem.h"
+#include "SplineNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 ASplineFollowerBase::ASplineFollowerBase()
 {
     bReplicates = true;
-    bIsFollowing = true;
+    FollowState.bIsFollowing = true;
+
+    // A follower's own spline is usually a copy of the one it rides on
+    bAddToSpatialIndex = false;
+    OwnSplineComponent = SplineComponent;
 
     MovementSpeed = 100.0f;
 }
@@ -22,29 +30,112 @@ void ASplineFollowerBase::BeginPlay()
 {
     Super::BeginPlay();
 
-    if (SplineComponent)
+    ResetStartPosition();
+
+    // Anchor the replicated follow state at the start position, clients take it from the server
+    if (HasAuthority())
+    {
+        RebaseFollowState(FollowState.bIsFollowing);
+    }
+    else
     {
-        // Generate a random starting position along the spline
-        const float SplineLength = SplineComponent->GetSplineLength();
+        UpdateSplinePositionFromState();
+    }
 
-        if (bFollowSplineAtRandomPosition) {
-            CurrentSplinePosition = FMath::FRandRange(0.0f, SplineLength);
-        }
-        else {
-            // Clamp the StartFollowingSplineAt variable to be between 0 and 1
-            StartFollowingSplineAt = FMath::Clamp(StartFollowingSplineAt, 0.0f, 1.0f);
+    // Start following spline if enabled
+    if (HasAuthority() && bStartFollowOnBeginPlay)
+    {
+        StartFollowingSpline();
+    }
 
-            // Calculate the position based on the clamped StartFollowingSplineAt
-            CurrentSplinePosition = StartFollowingSplineAt * SplineLength;
+    // The follow state is deterministic between changes, nothing has to be sent while it stays the same
+    if (HasAuthority() && bUseNetDormancy)
+    {
+        SetNetDormancy(DORM_DormantAll);
+    }
 
+    bCanSkipPhysicsStateSync = bSkipPhysicsStateSync && HasQueryOnlyCollision();
+
+    // Hand the per-frame update over to the batched subsystem
+    if (bUseBatchedUpdate)
+    {
+        if (USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>())
+        {
+            FollowerSubsystem->RegisterFollower(this);
+            SetActorTickEnabled(false);
         }
     }
+}
 
-    // Start following spline if enabled
-    if (HasAuthority() && bStartFollowOnBeginPlay)
+// Pick the start distance from the random or fixed start settings
+void ASplineFollowerBase::ResetStartPosition()
+{
+    if (!SplineComponent) return;
+
+    // Generate a random starting position along the spline
+    const float SplineLength = SplineComponent->GetSplineLength();
+
+    if (bFollowSplineAtRandomPosition) {
+        CurrentSplinePosition = FMath::FRandRange(0.0f, SplineLength);
+    }
+    else {
+        // Clamp the StartFollowingSplineAt variable to be between 0 and 1
+        StartFollowingSplineAt = FMath::Clamp(StartFollowingSplineAt, 0.0f, 1.0f);
+
+        // Calculate the position based on the clamped StartFollowingSplineAt
+        CurrentSplinePosition = StartFollowingSplineAt * SplineLength;
+    }
+}
+
+// Park the follower in a pool, hidden and without any per-frame work
+void ASplineFollowerBase::OnReleasedToPool()
+{
+    // Pooled followers start on their own spline again
+    if (IsValid(NetworkRoute.Network))
     {
-        StartFollowingSpline();
+        NetworkRoute.Network->OnGraphChanged.Remove(NetworkChangedHandle);
+    }
+    NetworkChangedHandle.Reset();
+    NetworkRoute = FSplineNetworkRoute();
+    AdoptedSpline = nullptr;
+    FollowState.bStopAtEnd = false;
+    MARK_PROPERTY_DIRTY_FROM_NAME(ASplineFollowerBase, NetworkRoute, this);
+    MARK_PROPERTY_DIRTY_FROM_NAME(ASplineFollowerBase, AdoptedSpline, this);
+    SetSplineComponent(OwnSplineComponent);
+
+    StopFollowingSpline();
+    ParkInPool(*this);
+}
+
+// Reset the spline position and state as if the follower was just spawned
+void ASplineFollowerBase::OnAcquiredFromPool()
+{
+    SplineCursor.Reset();
+    ResetStartPosition();
+
+    if (HasAuthority())
+    {
+        RebaseFollowState(bStartFollowOnBeginPlay);
+    }
+
+    MoveToSplinePosition();
+    UnparkFromPool(*this, bUseBatchedUpdate);
+}
+
+// EndPlay
+void ASplineFollowerBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>())
+    {
+        FollowerSubsystem->UnregisterFollower(this);
+    }
+
+    if (IsValid(NetworkRoute.Network))
+    {
+        NetworkRoute.Network->OnGraphChanged.Remove(NetworkChangedHandle);
     }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void ASplineFollowerBase::SetSplineComponent(USplineComponent* NewSplineComponent)
@@ -52,6 +143,158 @@ void ASplineFollowerBase::SetSplineComponent(USplineComponent* NewSplineComponen
     if (NewSplineComponent)
     {
         SplineComponent = NewSplineComponent;
+        SplineCursor.Reset();
+        DistanceTable.Reset();
+        RefreshBatchedState();
+        OnFollowedSplineChanged();
+    }
+}
+
+void ASplineFollowerBase::SetMovementSpeed(float NewMovementSpeed)
+{
+    MovementSpeed = NewMovementSpeed;
+
+    if (HasAuthority())
+    {
+        UpdateSplinePositionFromState();
+        RebaseFollowState(FollowState.bIsFollowing);
+    }
+}
+
+bool ASplineFollowerBase::FollowNetworkRoute(ASplineNetwork* Network, int32 FromNode, int32 ToNode)
+{
+    if (!HasAuthority() || !Network || !Network->GetRouteSpline(FromNode, ToNode))
+    {
+        return false;
+    }
+
+    if (bUseNetDormancy && NetDormancy > DORM_Awake)
+    {
+        FlushNetDormancy();
+    }
+
+    if (IsValid(NetworkRoute.Network) && NetworkRoute.Network != Network)
+    {
+        NetworkRoute.Network->OnGraphChanged.Remove(NetworkChangedHandle);
+        NetworkChangedHandle.Reset();
+    }
+
+    NetworkRoute.Network = Network;
+    NetworkRoute.FromNode = FromNode;
+    NetworkRoute.ToNode = ToNode;
+    AdoptedSpline = nullptr;
+    MARK_PROPERTY_DIRTY_FROM_NAME(ASplineFollowerBase, NetworkRoute, this);
+    MARK_PROPERTY_DIRTY_FROM_NAME(ASplineFollowerBase, AdoptedSpline, this);
+
+    ApplyNetworkRoute();
+
+    CurrentSplinePosition = 0.0f;
+    FollowState.bStopAtEnd = true;
+    RebaseFollowState(true);
+    MoveToSplinePosition();
+
+    return true;
+}
+
+void ASplineFollowerBase::ApplyNetworkRoute()
+{
+    ASplineNetwork* Network = NetworkRoute.Network;
+    if (!Network)
+    {
+        return;
+    }
+
+    if (!NetworkChangedHandle.IsValid())
+    {
+        NetworkChangedHandle = Network->OnGraphChanged.AddUObject(this, &ASplineFollowerBase::ApplyNetworkRoute);
+    }
+
+    // The route spline is shared with every follower on the same route. The previous one is destroyed by now,
+    // so without a route after the rebuild the follower goes back to its own spline
+    USplineComponent* RouteSpline = Network->GetRouteSpline(NetworkRoute.FromNode, NetworkRoute.ToNode);
+    SetSplineComponent(RouteSpline ? RouteSpline : OwnSplineComponent);
+}
+
+void ASplineFollowerBase::OnRep_NetworkRoute()
+{
+    ApplyNetworkRoute();
+
+    if (!SplineComponent || !ActiveMesh) return;
+
+    UpdateSplinePositionFromState();
+    MoveToSplinePosition();
+}
+
+void ASplineFollowerBase::OnRep_AdoptedSpline()
+{
+    SetSplineComponent(AdoptedSpline ? AdoptedSpline : OwnSplineComponent);
+
+    if (!SplineComponent || !ActiveMesh) return;
+
+    UpdateSplinePositionFromState();
+    MoveToSplinePosition();
+}
+
+void ASplineFollowerBase::AdoptFollowState(USplineComponent* Spline, const FSplineFollowState& NewFollowState)
+{
+    if (bUseNetDormancy && NetDormancy > DORM_Awake)
+    {
+        FlushNetDormancy();
+    }
+
+    SetSplineComponent(Spline);
+
+    // Clients resolve the spline through this reference, the follow state alone would land on their own spline
+    AdoptedSpline = Spline != OwnSplineComponent ? Spline : nullptr;
+    MARK_PROPERTY_DIRTY_FROM_NAME(ASplineFollowerBase, AdoptedSpline, this);
+
+    MovementSpeed = NewFollowState.Speed;
+    FollowState = NewFollowState;
+    MARK_PROPERTY_DIRTY_FROM_NAME(ASplineFollowerBase, FollowState, this);
+
+    UpdateSplinePositionFromState();
+    RefreshBatchedState();
+    OnFollowStateChanged();
+    MoveToSplinePosition();
+}
+
+// Restart the deterministic follow state from the current distance and server time
+void ASplineFollowerBase::RebaseFollowState(bool bFollowing)
+{
+    // Dormant followers replicate the new state once and go back to sleep
+    if (bUseNetDormancy && NetDormancy > DORM_Awake)
+    {
+        FlushNetDormancy();
+    }
+
+    const float SplineLength = SplineComponent ? SplineComponent->GetSplineLength() : 0.0f;
+    FollowState.StartDistance.Set(CurrentSplinePosition, SplineLength, DistanceQuantizationBits);
+    FollowState.StartServerTime = FSplineFollowState::GetServerTime(GetWorld());
+    FollowState.Speed = MovementSpeed;
+    FollowState.bIsFollowing = bFollowing;
+    MARK_PROPERTY_DIRTY_FROM_NAME(ASplineFollowerBase, FollowState, this);
+
+    RefreshBatchedState();
+    OnFollowStateChanged();
+}
+
+// Only used when not batched, the subsystem applies the same bands to batched followers
+bool ASplineFollowerBase::ConsumeLODFrame(float& DeltaTime)
+{
+    return !LODSettings.bEnabled || LODTicker.ConsumeFrame(*this, LODSettings, GetSplineRelevancyLocation(), DeltaTime);
+}
+
+// Push changed follow state to the batched subsystem
+void ASplineFollowerBase::RefreshBatchedState()
+{
+    if (GetSplineBatchHandle() == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>())
+    {
+        FollowerSubsystem->RefreshFollower(this);
     }
 }
 
@@ -60,7 +303,7 @@ void ASplineFollowerBase::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
-    if (bIsFollowing)
+    if (FollowState.bIsFollowing && ConsumeLODFrame(DeltaTime))
     {
         if (HasAuthority())
         {
@@ -76,13 +319,21 @@ void ASplineFollowerBase::Tick(float DeltaTime)
 // Start following the spline
 void ASplineFollowerBase::StartFollowingSpline()
 {
-    bIsFollowing = true;
+    if (HasAuthority())
+    {
+        UpdateSplinePositionFromState();
+        RebaseFollowState(true);
+    }
 }
 
 // Stop following the spline
 void ASplineFollowerBase::StopFollowingSpline()
 {
-    bIsFollowing = false;
+    if (HasAuthority())
+    {
+        UpdateSplinePositionFromState();
+        RebaseFollowState(false);
+    }
 }
 
 // Update position along the spline
@@ -92,50 +343,157 @@ void ASplineFollowerBase::UpdateSplinePosition(float DeltaTime)
 
     if (!ActiveMesh) return;
 
-    CurrentSplinePosition += MovementSpeed * DeltaTime;
+    UpdateSplinePositionFromState();
+    MoveToSplinePosition();
+}
+
+// Predict client movement
+void ASplineFollowerBase::PredictClientMovement(float DeltaTime)
+{
+    if (!SplineComponent) return;
 
-    if (CurrentSplinePosition > SplineComponent->GetSplineLength())
+    //UMeshComponent* ActiveMesh = bUseSkeletalMesh ? Cast<UMeshComponent>(SkeletalMeshComponent) : Cast<UMeshComponent>(StaticMeshComponent);
+    if (!ActiveMesh) return;
+
+    UpdateSplinePositionFromState();
+    PredictToSplinePosition(DeltaTime);
+}
+
+// Called by the batched subsystem with the already advanced distance and its evaluated transform
+void ASplineFollowerBase::ApplySplineTransform(float NewSplinePosition, const FVector& Location, const FRotator& Rotation, float DeltaTime)
+{
+    CurrentSplinePosition = NewSplinePosition;
+
+    if (!ActiveMesh) return;
+
+    FVector NewLocation = Location;
+    NewLocation.Z = ActiveMesh->GetComponentLocation().Z;
+
+    FRotator NewRotation = Rotation;
+    NewRotation.Yaw -= 90.0f;
+
+    if (HasAuthority())
+    {
+        SnapMeshTo(NewLocation, NewRotation);
+    }
+    else
     {
-        CurrentSplinePosition = 0.0f;
+        InterpolateMovement(NewLocation, NewRotation, DeltaTime);
     }
+}
 
-    FVector NewLocation = SplineComponent->GetLocationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
-    NewLocation.Z = ActiveMesh->GetComponentLocation().Z;
+// Derive the distance along the spline from the follow state and the server clock
+void ASplineFollowerBase::UpdateSplinePositionFromState()
+{
+    if (!SplineComponent) return;
+
+    CurrentSplinePosition = FollowState.GetDistanceAtTime(FSplineFollowState::GetServerTime(GetWorld()), SplineComponent->GetSplineLength());
+}
+
+// Snap the mesh to the current spline position
+void ASplineFollowerBase::MoveToSplinePosition()
+{
+    if (!SplineComponent || !ActiveMesh) return;
+
+    FVector NewLocation;
+    FRotator NewRotation;
+    EvaluateSplineAtDistance(CurrentSplinePosition, NewLocation, NewRotation);
 
-    FRotator NewRotation = SplineComponent->GetRotationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
+    NewLocation.Z = ActiveMesh->GetComponentLocation().Z;
     NewRotation.Yaw -= 90.0f;
 
+    SnapMeshTo(NewLocation, NewRotation);
+}
+
+// Move the mesh once it drifted further than the tolerance
+void ASplineFollowerBase::SnapMeshTo(const FVector& NewLocation, const FRotator& NewRotation)
+{
     if (FVector::Dist(NewLocation, ActiveMesh->GetComponentLocation()) > Tolerance)
     {
-        ActiveMesh->SetWorldLocation(NewLocation);
-        ActiveMesh->SetWorldRotation(NewRotation);
+        CommitMeshTransform(NewLocation, NewRotation.Quaternion(), ETeleportType::None);
     }
 }
 
-// Predict client movement
-void ASplineFollowerBase::PredictClientMovement(float DeltaTime)
+// Write location and rotation as one move, children and overlaps are updated once when the scope ends
+void ASplineFollowerBase::CommitMeshTransform(const FVector& NewLocation, const FQuat& NewRotation, ETeleportType Teleport)
 {
-    if (!SplineComponent) return;
+    FScopedMovementUpdate ScopedMovement(ActiveMesh, EScopedUpdate::DeferredUpdates);
 
-    //UMeshComponent* ActiveMesh = bUseSkeletalMesh ? Cast<UMeshComponent>(SkeletalMeshComponent) : Cast<UMeshComponent>(StaticMeshComponent);
-    if (!ActiveMesh) return;
+    // Teleports always sync the bodies so traces catch up with the skipped moves
+    const EMoveComponentFlags MoveFlags = bCanSkipPhysicsStateSync && Teleport == ETeleportType::None ? MOVECOMP_SkipPhysicsMove : MOVECOMP_NoFlags;
+    ActiveMesh->MoveComponent(NewLocation - ActiveMesh->GetComponentLocation(), NewRotation, false, nullptr, MoveFlags, Teleport);
+}
 
-    CurrentSplinePosition += MovementSpeed * DeltaTime;
+// True when neither the mesh nor anything attached to it has physics collision
+bool ASplineFollowerBase::HasQueryOnlyCollision() const
+{
+    if (!ActiveMesh || ActiveMesh->IsPhysicsCollisionEnabled())
+    {
+        return false;
+    }
 
-    if (CurrentSplinePosition > SplineComponent->GetSplineLength())
+    TArray<USceneComponent*> Children;
+    ActiveMesh->GetChildrenComponents(true, Children);
+
+    for (const USceneComponent* Child : Children)
     {
-        CurrentSplinePosition = 0.0f;
+        const UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Child);
+        if (Primitive && Primitive->IsPhysicsCollisionEnabled())
+        {
+            return false;
+        }
     }
 
-    FVector PredictedLocation = SplineComponent->GetLocationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
-    PredictedLocation.Z = ActiveMesh->GetComponentLocation().Z;
+    return true;
+}
+
+// Smoothly move the mesh towards the current spline position
+void ASplineFollowerBase::PredictToSplinePosition(float DeltaTime)
+{
+    if (!SplineComponent || !ActiveMesh) return;
+
+    FVector PredictedLocation;
+    FRotator PredictedRotation;
+    EvaluateSplineAtDistance(CurrentSplinePosition, PredictedLocation, PredictedRotation);
 
-    FRotator PredictedRotation = SplineComponent->GetRotationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
+    PredictedLocation.Z = ActiveMesh->GetComponentLocation().Z;
     PredictedRotation.Yaw -= 90.0f;
 
     InterpolateMovement(PredictedLocation, PredictedRotation, DeltaTime);
 }
 
+// Shared baked table for the followed spline, refreshed when the spline changed
+TSharedPtr<const FSplineDistanceTable> ASplineFollowerBase::GetDistanceTable()
+{
+    if (!bUseBakedDistanceTable || !SplineComponent)
+    {
+        return nullptr;
+    }
+
+    if (!DistanceTable.IsValid() || !DistanceTable->IsUpToDate(*SplineComponent))
+    {
+        if (USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>())
+        {
+            DistanceTable = FollowerSubsystem->FindOrBuildDistanceTable(SplineComponent, BakedSampleSpacing, BakedMaxError);
+        }
+    }
+
+    return DistanceTable;
+}
+
+// Evaluate the followed spline in world space, through the baked distance table when enabled
+// or else through the incremental reparam cursor
+void ASplineFollowerBase::EvaluateSplineAtDistance(float Distance, FVector& OutLocation, FRotator& OutRotation)
+{
+    if (const TSharedPtr<const FSplineDistanceTable> Table = GetDistanceTable())
+    {
+        Table->SampleWorld(Distance, SplineComponent->GetComponentTransform(), OutLocation, OutRotation);
+        return;
+    }
+
+    SplineCursor.EvaluateWorld(*SplineComponent, Distance, OutLocation, OutRotation);
+}
+
 // Interpolate movement
 void ASplineFollowerBase::InterpolateMovement(FVector TargetLocation, FRotator TargetRotation, float DeltaTime)
 {
@@ -150,8 +508,19 @@ void ASplineFollowerBase::InterpolateMovement(FVector TargetLocation, FRotator T
     FQuat TargetRotationQuat = FQuat(TargetRotation);
     FQuat SmoothedRotationQuat = FQuat::Slerp(CurrentRotationQuat, TargetRotationQuat, DeltaTime * InterpolationSpeed);
 
-    ActiveMesh->SetWorldLocation(SmoothedLocation);
-    ActiveMesh->SetWorldRotation(SmoothedRotationQuat.Rotator());
+    CommitMeshTransform(SmoothedLocation, SmoothedRotationQuat, ETeleportType::None);
+}
+
+// Distance culling against the position on the spline, which is known without moving any component
+bool ASplineFollowerBase::IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const
+{
+    const TOptional<bool> bSplineRelevant = IsSplineNetRelevantFor(*this, bUseSplineRelevancy, RealViewer, ViewTarget, SrcLocation, DistanceTable.Get());
+    return bSplineRelevant.IsSet() ? bSplineRelevant.GetValue() : Super::IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation);
+}
+
+FVector ASplineFollowerBase::GetSplineRelevancyLocation() const
+{
+    return ComputeSplineRelevancyLocation(*this, DistanceTable.Get());
 }
 
 // Replication
@@ -159,28 +528,35 @@ void ASplineFollowerBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    DOREPLIFETIME(ASplineFollowerBase, CurrentSplinePosition);
-    DOREPLIFETIME(ASplineFollowerBase, bIsFollowing);
+    // Push based, the state is only compared after RebaseFollowState marked it dirty
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+    DOREPLIFETIME_WITH_PARAMS_FAST(ASplineFollowerBase, FollowState, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(ASplineFollowerBase, NetworkRoute, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(ASplineFollowerBase, AdoptedSpline, Params);
 }
 
-void ASplineFollowerBase::OnRep_CurrentSplinePosition()
+void ASplineFollowerBase::OnRep_FollowState()
 {
-    if (!SplineComponent) return;
+    RefreshBatchedState();
+    OnFollowStateChanged();
 
-    // Get the new location along the spline
-    FVector NewLocation = SplineComponent->GetLocationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
+    if (!SplineComponent || !ActiveMesh) return;
+
+    UpdateSplinePositionFromState();
+
+    // Get the new location and rotation along the spline
+    FVector NewLocation;
+    FRotator NewRotation;
+    EvaluateSplineAtDistance(CurrentSplinePosition, NewLocation, NewRotation);
 
     // Preserve the current Z location to avoid abrupt height changes
     FVector CurrentMeshLocation = ActiveMesh->GetComponentLocation();
     NewLocation.Z = CurrentMeshLocation.Z;
 
-    // Get the new rotation along the spline
-    FRotator NewRotation = SplineComponent->GetRotationAtDistanceAlongSpline(CurrentSplinePosition, ESplineCoordinateSpace::World);
-
     // Apply an adjustment to the yaw to align the mesh correctly
     NewRotation.Yaw -= 90.0f;
 
-    // Update the position and rotation of the selected mesh
-    ActiveMesh->SetWorldLocation(NewLocation);
-    ActiveMesh->SetWorldRotation(NewRotation);
+    // Update the position and rotation of the selected mesh, the jump is a teleport for physics
+    CommitMeshTransform(NewLocation, NewRotation.Quaternion(), ETeleportType::TeleportPhysics);
 }
\ No newline at end of file
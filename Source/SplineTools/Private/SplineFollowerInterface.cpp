@@ -0,0 +1,84 @@
+#include "SplineFollowerInterface.h"
+#include "SplineDistanceTable.h"
+#include "SplineFollowState.h"
+#include "SplineFollowerSubsystem.h"
+#include "Components/SplineComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+TOptional<bool> ISplineFollowerInterface::IsSplineNetRelevantFor(const AActor& Actor, bool bUseSplineRelevancy, const AActor* RealViewer, const AActor* ViewTarget,
+    const FVector& SrcLocation, const FSplineDistanceTable* Table) const
+{
+    // Owner relevancy is left to AActor::IsNetRelevantFor
+    if (!bUseSplineRelevancy || !GetFollowedSpline() || Actor.bAlwaysRelevant || Actor.bOnlyRelevantToOwner || (Actor.bNetUseOwnerRelevancy && Actor.GetOwner()))
+    {
+        return {};
+    }
+
+    if (Actor.IsOwnedBy(ViewTarget) || Actor.IsOwnedBy(RealViewer) || &Actor == ViewTarget || ViewTarget == Actor.GetInstigator())
+    {
+        return true;
+    }
+
+    // Hidden actors without collision are irrelevant like in AActor::IsNetRelevantFor, e.g. followers parked in a pool
+    const USceneComponent* Root = Actor.GetRootComponent();
+    if (Actor.IsHidden() && (!Root || !Root->IsCollisionEnabled()))
+    {
+        return false;
+    }
+
+    // The position on the spline is known without moving any component
+    return FVector::DistSquared(SrcLocation, ComputeSplineRelevancyLocation(Actor, Table)) < Actor.GetNetCullDistanceSquared();
+}
+
+FVector ISplineFollowerInterface::ComputeSplineRelevancyLocation(const AActor& Actor, const FSplineDistanceTable* Table) const
+{
+    const USplineComponent* Spline = GetFollowedSpline();
+    if (!Spline)
+    {
+        return Actor.GetActorLocation();
+    }
+
+    const float SplineLength = Spline->GetSplineLength();
+    const float Distance = GetFollowState().GetDistanceAtTime(FSplineFollowState::GetServerTime(Actor.GetWorld()), SplineLength);
+
+    if (Table && Table->IsUpToDate(*Spline))
+    {
+        FVector Location;
+        FRotator Rotation;
+        Table->SampleWorld(Distance, Spline->GetComponentTransform(), Location, Rotation);
+        return Location;
+    }
+
+    return Spline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+}
+
+void ISplineFollowerInterface::ParkInPool(AActor& Actor)
+{
+    if (USplineFollowerSubsystem* FollowerSubsystem = Actor.GetWorld()->GetSubsystem<USplineFollowerSubsystem>())
+    {
+        FollowerSubsystem->UnregisterFollower(&Actor);
+    }
+
+    Actor.FlushNetDormancy();
+    Actor.SetActorHiddenInGame(true);
+    Actor.SetActorEnableCollision(false);
+    Actor.SetActorTickEnabled(false);
+}
+
+void ISplineFollowerInterface::UnparkFromPool(AActor& Actor, bool bUseBatchedUpdate)
+{
+    Actor.FlushNetDormancy();
+    Actor.SetActorHiddenInGame(false);
+    Actor.SetActorEnableCollision(true);
+
+    USplineFollowerSubsystem* FollowerSubsystem = Actor.GetWorld()->GetSubsystem<USplineFollowerSubsystem>();
+    if (bUseBatchedUpdate && FollowerSubsystem)
+    {
+        FollowerSubsystem->RegisterFollower(&Actor);
+    }
+    else
+    {
+        Actor.SetActorTickEnabled(true);
+    }
+}
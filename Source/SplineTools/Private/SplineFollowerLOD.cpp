@@ -0,0 +1,30 @@
+#include "SplineFollowerLOD.h"
+#include "SplineFollowerSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+bool FSplineFollowerLODTicker::ConsumeFrame(const AActor& Actor, const FSplineFollowerLODSettings& Settings, const FVector& FollowerLocation, float& DeltaTime)
+{
+    if (!Settings.bEnabled)
+    {
+        return true;
+    }
+
+    PendingDeltaTime += DeltaTime;
+
+    const UWorld* World = Actor.GetWorld();
+    const USplineFollowerSubsystem* FollowerSubsystem = World ? World->GetSubsystem<USplineFollowerSubsystem>() : nullptr;
+    const float ViewerDistanceSquared = FollowerSubsystem ? FollowerSubsystem->GetClosestViewerDistanceSquared(FollowerLocation) : 0.0f;
+    const bool bRecentlyRendered = Actor.GetNetMode() == NM_DedicatedServer || Actor.WasRecentlyRendered(FSplineFollowerLODSettings::RecentlyRenderedTime);
+
+    // Spread followers of the same band over different frames by their object id
+    const int32 Interval = Settings.GetUpdateInterval(ViewerDistanceSquared, bRecentlyRendered);
+    if (Interval == 0 || !FSplineFollowerLODSettings::IsUpdateFrame(Interval, Actor.GetUniqueID()))
+    {
+        return false;
+    }
+
+    DeltaTime = PendingDeltaTime;
+    PendingDeltaTime = 0.0f;
+    return true;
+}
@@ -0,0 +1,172 @@
+#include "SplineFollowerPoolSubsystem.h"
+#include "SplineFollowerInterface.h"
+#include "SplineTrackerActor.h"
+#include "SplineSpatialIndexSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Stats/Stats.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spline Pool Hits"), STAT_SplinePoolHits, STATGROUP_Game);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spline Pool Misses"), STAT_SplinePoolMisses, STATGROUP_Game);
+
+bool USplineFollowerPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USplineFollowerPoolSubsystem::Deinitialize()
+{
+    Pools.Empty();
+
+    Super::Deinitialize();
+}
+
+void USplineFollowerPoolSubsystem::Prewarm(TSubclassOf<AActor> Class, int32 Count)
+{
+    if (!Class)
+    {
+        return;
+    }
+
+    FSplineActorPool& Pool = Pools.FindOrAdd(Class);
+    while (Pool.Actors.Num() < Count)
+    {
+        AActor* Actor = SpawnPooledActor(Class, FTransform::Identity);
+        if (!Actor)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Failed to prewarm %s."), *Class->GetName());
+            return;
+        }
+
+        Deactivate(Actor);
+        Pool.Actors.Add(Actor);
+    }
+}
+
+AActor* USplineFollowerPoolSubsystem::AcquireActor(TSubclassOf<AActor> Class, const FTransform& Transform)
+{
+    if (!Class)
+    {
+        return nullptr;
+    }
+
+    if (FSplineActorPool* Pool = Pools.Find(Class))
+    {
+        while (Pool->Actors.Num() > 0)
+        {
+            AActor* Actor = Pool->Actors.Pop();
+            if (IsValid(Actor))
+            {
+                ++Hits;
+                INC_DWORD_STAT(STAT_SplinePoolHits);
+
+                Activate(Actor, Transform);
+                return Actor;
+            }
+        }
+    }
+
+    ++Misses;
+    INC_DWORD_STAT(STAT_SplinePoolMisses);
+
+    // A fresh actor runs BeginPlay, which already sets up its spline state
+    return SpawnPooledActor(Class, Transform);
+}
+
+void USplineFollowerPoolSubsystem::ReleaseActor(AActor* Actor)
+{
+    if (!IsValid(Actor))
+    {
+        return;
+    }
+
+    FSplineActorPool& Pool = Pools.FindOrAdd(Actor->GetClass());
+    if (Pool.Actors.Contains(Actor))
+    {
+        return;
+    }
+
+    Deactivate(Actor);
+    Pool.Actors.Add(Actor);
+}
+
+FSplineFollowerPoolStats USplineFollowerPoolSubsystem::GetPoolStats() const
+{
+    FSplineFollowerPoolStats Stats;
+    Stats.Hits = Hits;
+    Stats.Misses = Misses;
+
+    for (const TPair<UClass*, FSplineActorPool>& Pool : Pools)
+    {
+        Stats.NumPooled += Pool.Value.Actors.Num();
+    }
+
+    return Stats;
+}
+
+void USplineFollowerPoolSubsystem::ResetPoolStats()
+{
+    Hits = 0;
+    Misses = 0;
+}
+
+AActor* USplineFollowerPoolSubsystem::SpawnPooledActor(UClass* Class, const FTransform& Transform)
+{
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    return GetWorld()->SpawnActor<AActor>(Class, Transform, SpawnParams);
+}
+
+void USplineFollowerPoolSubsystem::Deactivate(AActor* Actor)
+{
+    UpdateSpatialIndex(Actor, true);
+
+    if (ISplineFollowerInterface* Follower = Cast<ISplineFollowerInterface>(Actor))
+    {
+        Follower->OnReleasedToPool();
+        return;
+    }
+
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    Actor->SetActorTickEnabled(false);
+}
+
+void USplineFollowerPoolSubsystem::Activate(AActor* Actor, const FTransform& Transform)
+{
+    Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+    UpdateSpatialIndex(Actor, false);
+
+    if (ISplineFollowerInterface* Follower = Cast<ISplineFollowerInterface>(Actor))
+    {
+        Follower->OnAcquiredFromPool();
+        return;
+    }
+
+    Actor->SetActorHiddenInGame(false);
+    Actor->SetActorEnableCollision(true);
+    Actor->SetActorTickEnabled(true);
+}
+
+void USplineFollowerPoolSubsystem::UpdateSpatialIndex(AActor* Actor, bool bParked)
+{
+    const ASplineTrackerActor* Tracker = Cast<ASplineTrackerActor>(Actor);
+    if (!Tracker || !Tracker->bAddToSpatialIndex || !Tracker->SplineComponent)
+    {
+        return;
+    }
+
+    if (USplineSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<USplineSpatialIndexSubsystem>())
+    {
+        if (bParked)
+        {
+            SpatialIndex->RemoveSpline(Tracker->SplineComponent);
+        }
+        else
+        {
+            // Added again at the transform the tracker was handed out with
+            SpatialIndex->AddSpline(Tracker->SplineComponent);
+        }
+    }
+}
@@ -0,0 +1,477 @@
+#include "SplineFollowerSubsystem.h"
+#include "SplineFollowerInterface.h"
+#include "SplineInstancedFollowerManager.h"
+#include "Components/SplineComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Async/ParallelFor.h"
+
+// Below this many followers the evaluation runs on the game thread only
+static constexpr int32 ParallelEvaluationThreshold = 64;
+
+bool USplineFollowerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USplineFollowerSubsystem::Deinitialize()
+{
+    for (int32 i = 0; i < Followers.Num(); ++i)
+    {
+        if (FollowerActors[i].IsValid())
+        {
+            Followers[i]->SetSplineBatchHandle(INDEX_NONE);
+        }
+    }
+
+    Followers.Empty();
+    FollowerActors.Empty();
+    Splines.Empty();
+    Distances.Empty();
+    StartAlphas.Empty();
+    StartTimes.Empty();
+    Speeds.Empty();
+    Flags.Empty();
+    Tables.Empty();
+    Cursors.Empty();
+    LODSettings.Empty();
+    TargetLocations.Empty();
+    TargetRotations.Empty();
+    PendingDeltaTimes.Empty();
+    ResolvedSplines.Empty();
+    UpdateModes.Empty();
+    ViewerLocations.Empty();
+    DistanceTables.Empty();
+    SharedRoutes.Empty();
+    SharedRouteKeys.Empty();
+    PrivateRouteRefCounts.Empty();
+    RouteHost = nullptr;
+    InstancedFollowerManager = nullptr;
+
+    Super::Deinitialize();
+}
+
+TStatId USplineFollowerSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USplineFollowerSubsystem, STATGROUP_Tickables);
+}
+
+void USplineFollowerSubsystem::RegisterFollower(AActor* FollowerActor)
+{
+    ISplineFollowerInterface* Follower = Cast<ISplineFollowerInterface>(FollowerActor);
+    if (!Follower || Follower->GetSplineBatchHandle() != INDEX_NONE)
+    {
+        return;
+    }
+
+    const int32 Index = Followers.Add(Follower);
+    FollowerActors.Add(FollowerActor);
+    Splines.AddDefaulted();
+    Distances.AddZeroed();
+    StartAlphas.AddZeroed();
+    StartTimes.AddZeroed();
+    Speeds.AddZeroed();
+    Flags.AddZeroed();
+    Tables.AddDefaulted();
+    Cursors.AddDefaulted();
+    LODSettings.Add(&Follower->GetLODSettings());
+    TargetLocations.Add(FollowerActor->GetActorLocation());
+    TargetRotations.Add(FollowerActor->GetActorRotation());
+    PendingDeltaTimes.AddZeroed();
+
+    Follower->SetSplineBatchHandle(Index);
+    ReadFollowerState(Index);
+}
+
+void USplineFollowerSubsystem::UnregisterFollower(AActor* FollowerActor)
+{
+    ISplineFollowerInterface* Follower = Cast<ISplineFollowerInterface>(FollowerActor);
+    if (!Follower)
+    {
+        return;
+    }
+
+    const int32 Index = Follower->GetSplineBatchHandle();
+    if (Followers.IsValidIndex(Index) && Followers[Index] == Follower)
+    {
+        RemoveFollowerAtSwap(Index);
+    }
+}
+
+void USplineFollowerSubsystem::RefreshFollower(AActor* FollowerActor)
+{
+    ISplineFollowerInterface* Follower = Cast<ISplineFollowerInterface>(FollowerActor);
+    if (!Follower)
+    {
+        return;
+    }
+
+    const int32 Index = Follower->GetSplineBatchHandle();
+    if (Followers.IsValidIndex(Index) && Followers[Index] == Follower)
+    {
+        ReadFollowerState(Index);
+    }
+}
+
+TSharedPtr<const FSplineDistanceTable> USplineFollowerSubsystem::FindOrBuildDistanceTable(const USplineComponent* Spline, float SampleSpacing, float MaxError)
+{
+    if (!Spline)
+    {
+        return nullptr;
+    }
+
+    TSharedPtr<FSplineDistanceTable>& Table = DistanceTables.FindOrAdd(Spline);
+    if (!Table.IsValid() || !Table->IsUpToDate(*Spline))
+    {
+        // Tables still held by followers keep their old data until they ask again
+        Table = MakeShared<FSplineDistanceTable>();
+        Table->Build(*Spline, SampleSpacing, MaxError);
+    }
+
+    return Table;
+}
+
+FSplineRouteKey FSplineRouteKey::FromSpline(const USplineComponent& Spline)
+{
+    FSplineRouteKey Key;
+    Key.Curves = Spline.SplineCurves;
+    Key.Settings = FSplineCurveBakeSettings(Spline);
+    Key.ComponentTransform = Spline.GetComponentTransform();
+
+    Key.Hash = FSplineCurveCopy::HashCurves(Key.Curves);
+    Key.Hash = HashCombine(Key.Hash, GetTypeHash(Key.ComponentTransform.GetLocation()));
+    Key.Hash = HashCombine(Key.Hash, GetTypeHash(Key.ComponentTransform.GetRotation()));
+    Key.Hash = HashCombine(Key.Hash, GetTypeHash(Key.ComponentTransform.GetScale3D()));
+    return Key;
+}
+
+USplineComponent* USplineFollowerSubsystem::AcquireSharedRoute(const USplineComponent* Source)
+{
+    if (!Source)
+    {
+        return nullptr;
+    }
+
+    FSplineRouteKey Key = FSplineRouteKey::FromSpline(*Source);
+    if (FSharedRoute* Route = SharedRoutes.Find(Key))
+    {
+        if (IsValid(Route->Spline))
+        {
+            ++Route->RefCount;
+            return Route->Spline;
+        }
+
+        SharedRoutes.Remove(Key);
+    }
+
+    USplineComponent* Spline = CreateRouteSpline(*Source);
+    if (!Spline)
+    {
+        return nullptr;
+    }
+
+    SharedRouteKeys.Add(Spline, Key);
+    SharedRoutes.Add(MoveTemp(Key), { Spline, 1 });
+    return Spline;
+}
+
+void USplineFollowerSubsystem::ReleaseSharedRoute(USplineComponent* Route)
+{
+    if (!Route)
+    {
+        return;
+    }
+
+    if (const FSplineRouteKey* Key = SharedRouteKeys.Find(Route))
+    {
+        FSharedRoute* SharedRoute = SharedRoutes.Find(*Key);
+        if (SharedRoute && --SharedRoute->RefCount > 0)
+        {
+            return;
+        }
+
+        SharedRoutes.Remove(*Key);
+        SharedRouteKeys.Remove(Route);
+    }
+    else if (int32* RefCount = PrivateRouteRefCounts.Find(Route))
+    {
+        if (--(*RefCount) > 0)
+        {
+            return;
+        }
+
+        PrivateRouteRefCounts.Remove(Route);
+    }
+    else
+    {
+        return;
+    }
+
+    DistanceTables.Remove(Route);
+    Route->DestroyComponent();
+}
+
+USplineComponent* USplineFollowerSubsystem::MakeRouteUnique(USplineComponent* Route)
+{
+    if (!Route)
+    {
+        return nullptr;
+    }
+
+    // Private copies and routes with a single user can be written in place
+    const FSplineRouteKey* Key = SharedRouteKeys.Find(Route);
+    const FSharedRoute* SharedRoute = Key ? SharedRoutes.Find(*Key) : nullptr;
+    if (!SharedRoute || SharedRoute->RefCount <= 1)
+    {
+        if (Key)
+        {
+            // The caller is about to change the points, so the route can no longer be found by them
+            PrivateRouteRefCounts.Add(Route, 1);
+            SharedRoutes.Remove(*Key);
+            SharedRouteKeys.Remove(Route);
+        }
+        return Route;
+    }
+
+    USplineComponent* Copy = CreateRouteSpline(*Route);
+    if (!Copy)
+    {
+        return Route;
+    }
+
+    PrivateRouteRefCounts.Add(Copy, 1);
+    ReleaseSharedRoute(Route);
+    return Copy;
+}
+
+USplineComponent* USplineFollowerSubsystem::CreateRouteSpline(const USplineComponent& Source)
+{
+    if (!RouteHost)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.ObjectFlags |= RF_Transient;
+        RouteHost = GetWorld()->SpawnActor<AActor>(SpawnParams);
+        if (!RouteHost)
+        {
+            return nullptr;
+        }
+
+        USceneComponent* Root = NewObject<USceneComponent>(RouteHost, TEXT("RouteRoot"));
+        RouteHost->SetRootComponent(Root);
+        Root->RegisterComponent();
+    }
+
+    USplineComponent* Spline = NewObject<USplineComponent>(RouteHost, NAME_None, RF_Transient);
+    Spline->SetupAttachment(RouteHost->GetRootComponent());
+    Spline->SetHiddenInGame(true);
+    Spline->RegisterComponent();
+
+    // Placed like the source first, so its reparam table can be reused, then the whole curves are copied with
+    // their tangents, rotations, scales and point types
+    Spline->SetWorldTransform(Source.GetComponentTransform());
+    FSplineCurveCopy::Copy(Source, *Spline);
+
+    return Spline;
+}
+
+ASplineInstancedFollowerManager* USplineFollowerSubsystem::GetInstancedFollowerManager()
+{
+    if (!IsValid(InstancedFollowerManager))
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.ObjectFlags |= RF_Transient;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        InstancedFollowerManager = GetWorld()->SpawnActor<ASplineInstancedFollowerManager>(SpawnParams);
+    }
+
+    return InstancedFollowerManager;
+}
+
+ASplineInstancedFollowerManager* USplineFollowerSubsystem::FindInstancedFollowerManager() const
+{
+    return IsValid(InstancedFollowerManager) ? InstancedFollowerManager : nullptr;
+}
+
+void USplineFollowerSubsystem::ReadFollowerState(int32 Index)
+{
+    ISplineFollowerInterface* Follower = Followers[Index];
+
+    Splines[Index] = Follower->GetFollowedSpline();
+    const FSplineFollowState& FollowState = Follower->GetFollowState();
+    Distances[Index] = Follower->GetSplinePosition();
+    StartAlphas[Index] = FollowState.StartDistance.Alpha;
+    StartTimes[Index] = FollowState.StartServerTime;
+    Speeds[Index] = FollowState.Speed;
+    Flags[Index] = static_cast<uint8>((FollowState.bIsFollowing ? Following : None) | (FollowState.bStopAtEnd ? StopAtEnd : None));
+    Tables[Index] = Follower->GetDistanceTable();
+    LODSettings[Index] = &Follower->GetLODSettings();
+
+    // The follower may have been moved or switched splines
+    Cursors[Index].Reset();
+}
+
+void USplineFollowerSubsystem::RemoveFollowerAtSwap(int32 Index)
+{
+    // Destroyed followers may already be garbage collected
+    if (FollowerActors[Index].IsValid())
+    {
+        Followers[Index]->SetSplineBatchHandle(INDEX_NONE);
+    }
+
+    Followers.RemoveAtSwap(Index);
+    FollowerActors.RemoveAtSwap(Index);
+    Splines.RemoveAtSwap(Index);
+    Distances.RemoveAtSwap(Index);
+    StartAlphas.RemoveAtSwap(Index);
+    StartTimes.RemoveAtSwap(Index);
+    Speeds.RemoveAtSwap(Index);
+    Flags.RemoveAtSwap(Index);
+    Tables.RemoveAtSwap(Index);
+    Cursors.RemoveAtSwap(Index);
+    LODSettings.RemoveAtSwap(Index);
+    TargetLocations.RemoveAtSwap(Index);
+    TargetRotations.RemoveAtSwap(Index);
+    PendingDeltaTimes.RemoveAtSwap(Index);
+
+    // The last follower was moved into the freed slot
+    if (Followers.IsValidIndex(Index) && FollowerActors[Index].IsValid())
+    {
+        Followers[Index]->SetSplineBatchHandle(Index);
+    }
+}
+
+void USplineFollowerSubsystem::Tick(float DeltaTime)
+{
+    // Drop followers that were destroyed without unregistering
+    for (int32 i = FollowerActors.Num() - 1; i >= 0; --i)
+    {
+        if (!FollowerActors[i].IsValid())
+        {
+            RemoveFollowerAtSwap(i);
+        }
+    }
+
+    // Drop tables of splines that no longer exist
+    for (auto It = DistanceTables.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().ResolveObjectPtr())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    const int32 NumFollowers = Distances.Num();
+    ResolvedSplines.SetNumUninitialized(NumFollowers);
+    UpdateModes.SetNumUninitialized(NumFollowers);
+
+    GatherViewerLocations();
+
+    // Resolve splines, pick LOD update modes and refresh stale distance tables on the game thread before going wide
+    for (int32 i = 0; i < NumFollowers; ++i)
+    {
+        PendingDeltaTimes[i] += DeltaTime;
+        UpdateModes[i] = SelectUpdateMode(i);
+
+        const USplineComponent* Spline = (Flags[i] & Following) && UpdateModes[i] != Skip ? Splines[i].Get() : nullptr;
+        ResolvedSplines[i] = Spline;
+
+        // Followers without a table at registration pick one up once their spline can be baked
+        if (Spline && (!Tables[i].IsValid() || !Tables[i]->IsUpToDate(*Spline)))
+        {
+            Tables[i] = Followers[i]->GetDistanceTable();
+        }
+    }
+
+    const double ServerTime = FSplineFollowState::GetServerTime(GetWorld());
+
+    // Derive distances from the follow states and evaluate target transforms into the flat buffers
+    ParallelFor(NumFollowers, [this, ServerTime](int32 i)
+    {
+        const USplineComponent* Spline = ResolvedSplines[i];
+        if (!Spline)
+        {
+            return;
+        }
+
+        const float SplineLength = Spline->GetSplineLength();
+        Distances[i] = FSplineFollowState::EvaluateDistance(StartAlphas[i] * SplineLength, StartTimes[i], Speeds[i], ServerTime, SplineLength, !(Flags[i] & StopAtEnd));
+
+        if (const FSplineDistanceTable* Table = Tables[i].Get())
+        {
+            Table->SampleWorld(Distances[i], Spline->GetComponentTransform(), TargetLocations[i], TargetRotations[i]);
+        }
+        else
+        {
+            Cursors[i].EvaluateWorld(*Spline, Distances[i], TargetLocations[i], TargetRotations[i]);
+        }
+    }, NumFollowers < ParallelEvaluationThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+    // Apply the evaluated transforms to the followers on the game thread, with the time accumulated since their last update
+    for (int32 i = 0; i < NumFollowers; ++i)
+    {
+        if (ResolvedSplines[i] && UpdateModes[i] == Apply)
+        {
+            Followers[i]->ApplySplineTransform(Distances[i], TargetLocations[i], TargetRotations[i], PendingDeltaTimes[i]);
+            PendingDeltaTimes[i] = 0.0f;
+        }
+    }
+}
+
+void USplineFollowerSubsystem::GatherViewerLocations()
+{
+    ViewerLocations.Reset();
+
+    // Remote player controllers are included on the server, their view point follows the replicated camera
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        if (const APlayerController* PlayerController = It->Get())
+        {
+            FVector ViewLocation;
+            FRotator ViewRotation;
+            PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+            ViewerLocations.Add(ViewLocation);
+        }
+    }
+}
+
+float USplineFollowerSubsystem::GetClosestViewerDistanceSquared(const FVector& Location) const
+{
+    if (ViewerLocations.Num() == 0)
+    {
+        return 0.0f;
+    }
+
+    float ClosestDistanceSquared = TNumericLimits<float>::Max();
+    for (const FVector& ViewerLocation : ViewerLocations)
+    {
+        ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, static_cast<float>(FVector::DistSquared(ViewerLocation, Location)));
+    }
+
+    return ClosestDistanceSquared;
+}
+
+USplineFollowerSubsystem::EUpdateMode USplineFollowerSubsystem::SelectUpdateMode(int32 Index)
+{
+    const FSplineFollowerLODSettings& Settings = *LODSettings[Index];
+    if (!Settings.bEnabled)
+    {
+        return Apply;
+    }
+
+    // A dedicated server renders nothing, only the distance bands apply there
+    const bool bRecentlyRendered = GetWorld()->GetNetMode() == NM_DedicatedServer || FollowerActors[Index]->WasRecentlyRendered(FSplineFollowerLODSettings::RecentlyRenderedTime);
+    const int32 Interval = Settings.GetUpdateInterval(GetClosestViewerDistanceSquared(TargetLocations[Index]), bRecentlyRendered);
+
+    // Culled followers still re-evaluate their position now and then to find their band again
+    const int32 Frames = Interval > 0 ? Interval : FMath::Clamp(Settings.CulledUpdateInterval, 1, 255);
+
+    // Spread followers of the same band over different frames by their batch index
+    if (!FSplineFollowerLODSettings::IsUpdateFrame(Frames, Index))
+    {
+        return Skip;
+    }
+
+    return Interval > 0 ? Apply : EvaluateOnly;
+}
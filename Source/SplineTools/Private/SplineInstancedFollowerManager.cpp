@@ -0,0 +1,270 @@
+#include "SplineInstancedFollowerManager.h"
+#include "SplineFollowerSubsystem.h"
+#include "Components/SplineComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Async/ParallelFor.h"
+
+ASplineInstancedFollowerManager::ASplineInstancedFollowerManager()
+{
+    PrimaryActorTick.bCanEverTick = true;
+    bReplicates = false;
+
+    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("DefaultSceneRoot"));
+    RootComponent->SetMobility(EComponentMobility::Static);
+}
+
+int32 ASplineInstancedFollowerManager::FindOrAddGroup(UStaticMesh* Mesh)
+{
+    if (const int32* ExistingGroup = GroupByMesh.Find(Mesh))
+    {
+        return *ExistingGroup;
+    }
+
+    // Plain instanced meshes instead of hierarchical ones, since every instance moves every frame
+    // and a hierarchical cluster tree would be rebuilt constantly
+    UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(this);
+    Component->SetStaticMesh(Mesh);
+    Component->SetMobility(EComponentMobility::Movable);
+    Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    Component->SetCanEverAffectNavigation(false);
+    Component->SetupAttachment(RootComponent);
+    Component->RegisterComponent();
+    InstanceComponents.Add(Component);
+
+    const int32 GroupIndex = Groups.AddDefaulted();
+    Groups[GroupIndex].Component = Component;
+    GroupByMesh.Add(Mesh, GroupIndex);
+
+    return GroupIndex;
+}
+
+ASplineInstancedFollowerManager::FInstanceGroup* ASplineInstancedFollowerManager::FindGroup(const FSplineInstanceHandle& Handle)
+{
+    if (!Groups.IsValidIndex(Handle.GroupIndex))
+    {
+        return nullptr;
+    }
+
+    FInstanceGroup& Group = Groups[Handle.GroupIndex];
+    if (!Group.Flags.IsValidIndex(Handle.InstanceIndex) || !(Group.Flags[Handle.InstanceIndex] & Active))
+    {
+        return nullptr;
+    }
+
+    return &Group;
+}
+
+FSplineInstanceHandle ASplineInstancedFollowerManager::AddFollower(UStaticMesh* Mesh, USplineComponent* Spline, float StartDistance, float Speed, bool bFollowing)
+{
+    // Local followers are not sent anywhere, keep the start distance at full precision
+    FSplineFollowState State;
+    State.StartDistance.Set(StartDistance, Spline ? Spline->GetSplineLength() : 0.0f, FSplineQuantizedDistance::MaxBits);
+    State.StartServerTime = FSplineFollowState::GetServerTime(GetWorld());
+    State.Speed = Speed;
+    State.bIsFollowing = bFollowing;
+
+    return AddFollowerWithState(Mesh, Spline, State);
+}
+
+FSplineInstanceHandle ASplineInstancedFollowerManager::AddFollowerWithState(UStaticMesh* Mesh, USplineComponent* Spline, const FSplineFollowState& State)
+{
+    FSplineInstanceHandle Handle;
+
+    if (!Mesh || !Spline)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Instanced spline follower needs a mesh and a spline."));
+        return Handle;
+    }
+
+    Handle.GroupIndex = FindOrAddGroup(Mesh);
+    FInstanceGroup& Group = Groups[Handle.GroupIndex];
+
+    USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>();
+    TSharedPtr<const FSplineDistanceTable> Table = FollowerSubsystem ? FollowerSubsystem->FindOrBuildDistanceTable(Spline, BakedSampleSpacing, BakedMaxError) : nullptr;
+
+    if (Group.FreeIndices.Num() > 0)
+    {
+        Handle.InstanceIndex = Group.FreeIndices.Pop();
+    }
+    else
+    {
+        Handle.InstanceIndex = Group.Component->AddInstance(FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), true);
+        Group.Splines.AddDefaulted();
+        Group.Tables.AddDefaulted();
+        Group.States.AddDefaulted();
+        Group.Heights.AddZeroed();
+        Group.Flags.AddZeroed();
+        Group.InstanceTransforms.AddDefaulted();
+    }
+
+    const int32 Index = Handle.InstanceIndex;
+    Group.Splines[Index] = Spline;
+    Group.Tables[Index] = Table;
+    Group.States[Index] = State;
+    Group.Heights[Index] = 0.0f;
+    Group.Flags[Index] = Active;
+
+    return Handle;
+}
+
+FSplineInstanceHandle ASplineInstancedFollowerManager::AddFollowerAtHeight(UStaticMesh* Mesh, USplineComponent* Spline, const FSplineFollowState& State, float FixedHeight)
+{
+    const FSplineInstanceHandle Handle = AddFollowerWithState(Mesh, Spline, State);
+
+    if (Handle.IsValid())
+    {
+        FInstanceGroup& Group = Groups[Handle.GroupIndex];
+        Group.Heights[Handle.InstanceIndex] = FixedHeight;
+        Group.Flags[Handle.InstanceIndex] |= KeepHeight;
+    }
+
+    return Handle;
+}
+
+void ASplineInstancedFollowerManager::RemoveFollower(FSplineInstanceHandle Handle)
+{
+    if (FInstanceGroup* Group = FindGroup(Handle))
+    {
+        const int32 Index = Handle.InstanceIndex;
+        Group->Flags[Index] = None;
+        Group->Splines[Index] = nullptr;
+        Group->Tables[Index].Reset();
+        Group->InstanceTransforms[Index] = FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+        Group->FreeIndices.Add(Index);
+    }
+}
+
+void ASplineInstancedFollowerManager::SetFollowerState(FSplineInstanceHandle Handle, USplineComponent* Spline, const FSplineFollowState& State)
+{
+    FInstanceGroup* Group = FindGroup(Handle);
+    if (!Group || !Spline)
+    {
+        return;
+    }
+
+    const int32 Index = Handle.InstanceIndex;
+    if (Group->Splines[Index].Get() != Spline)
+    {
+        USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>();
+        Group->Splines[Index] = Spline;
+        Group->Tables[Index] = FollowerSubsystem ? FollowerSubsystem->FindOrBuildDistanceTable(Spline, BakedSampleSpacing, BakedMaxError) : nullptr;
+    }
+
+    Group->States[Index] = State;
+}
+
+void ASplineInstancedFollowerManager::SetFollowerSpeed(FSplineInstanceHandle Handle, float Speed)
+{
+    if (FInstanceGroup* Group = FindGroup(Handle))
+    {
+        RebaseFollower(*Group, Handle.InstanceIndex, Speed, Group->States[Handle.InstanceIndex].bIsFollowing);
+    }
+}
+
+void ASplineInstancedFollowerManager::SetFollowerFollowing(FSplineInstanceHandle Handle, bool bFollowing)
+{
+    if (FInstanceGroup* Group = FindGroup(Handle))
+    {
+        RebaseFollower(*Group, Handle.InstanceIndex, Group->States[Handle.InstanceIndex].Speed, bFollowing);
+    }
+}
+
+void ASplineInstancedFollowerManager::RebaseFollower(FInstanceGroup& Group, int32 Index, float Speed, bool bFollowing)
+{
+    const USplineComponent* Spline = Group.Splines[Index].Get();
+    const float SplineLength = Spline ? Spline->GetSplineLength() : 0.0f;
+    const double ServerTime = FSplineFollowState::GetServerTime(GetWorld());
+
+    FSplineFollowState& State = Group.States[Index];
+    State.StartDistance.Set(State.GetDistanceAtTime(ServerTime, SplineLength), SplineLength, FSplineQuantizedDistance::MaxBits);
+    State.StartServerTime = ServerTime;
+    State.Speed = Speed;
+    State.bIsFollowing = bFollowing;
+}
+
+int32 ASplineInstancedFollowerManager::GetNumInstancedFollowers() const
+{
+    int32 NumFollowers = 0;
+    for (const FInstanceGroup& Group : Groups)
+    {
+        NumFollowers += Group.Flags.Num() - Group.FreeIndices.Num();
+    }
+    return NumFollowers;
+}
+
+void ASplineInstancedFollowerManager::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    const double ServerTime = FSplineFollowState::GetServerTime(GetWorld());
+    for (int32 GroupIndex = 0; GroupIndex < Groups.Num(); ++GroupIndex)
+    {
+        if (Groups[GroupIndex].Flags.Num() > Groups[GroupIndex].FreeIndices.Num())
+        {
+            UpdateGroup(GroupIndex, ServerTime);
+        }
+    }
+}
+
+void ASplineInstancedFollowerManager::UpdateGroup(int32 GroupIndex, double ServerTime)
+{
+    FInstanceGroup& Group = Groups[GroupIndex];
+    const int32 NumInstances = Group.Flags.Num();
+    Group.ResolvedSplines.SetNumUninitialized(NumInstances);
+
+    // Refresh tables of edited splines and drop instances whose spline is gone
+    USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>();
+    for (int32 i = 0; i < NumInstances; ++i)
+    {
+        const USplineComponent* Spline = (Group.Flags[i] & Active) ? Group.Splines[i].Get() : nullptr;
+        Group.ResolvedSplines[i] = Spline;
+
+        if (!Spline)
+        {
+            if (Group.Flags[i] & Active)
+            {
+                FSplineInstanceHandle StaleHandle;
+                StaleHandle.GroupIndex = GroupIndex;
+                StaleHandle.InstanceIndex = i;
+                RemoveFollower(StaleHandle);
+            }
+            continue;
+        }
+
+        if (FollowerSubsystem && (!Group.Tables[i].IsValid() || !Group.Tables[i]->IsUpToDate(*Spline)))
+        {
+            Group.Tables[i] = FollowerSubsystem->FindOrBuildDistanceTable(Spline, BakedSampleSpacing, BakedMaxError);
+        }
+    }
+
+    ParallelFor(NumInstances, [&Group, ServerTime](int32 i)
+    {
+        const USplineComponent* Spline = Group.ResolvedSplines[i];
+        if (!Spline || !Group.Tables[i].IsValid())
+        {
+            return;
+        }
+
+        // Same distance as a follower actor with this state, wrapped or clamped at the end
+        const uint8 InstanceFlags = Group.Flags[i];
+        const float Distance = Group.States[i].GetDistanceAtTime(ServerTime, Spline->GetSplineLength());
+
+        FVector Location;
+        FRotator Rotation;
+        Group.Tables[i]->SampleWorld(Distance, Spline->GetComponentTransform(), Location, Rotation);
+
+        if (InstanceFlags & KeepHeight)
+        {
+            Location.Z = Group.Heights[i];
+        }
+
+        // Same mesh alignment as ASplineFollowerBase
+        Rotation.Yaw -= 90.0f;
+
+        Group.InstanceTransforms[i] = FTransform(Rotation, Location);
+    });
+
+    Group.Component->BatchUpdateInstancesTransforms(0, Group.InstanceTransforms, true, true, true);
+}
@@ -0,0 +1,289 @@
+#include "SplineLibrary.h"
+#include "Components/SplineComponent.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+
+// 'SPLB' followed by the format version
+static constexpr uint32 SplineLibraryMagic = 0x424C5053;
+static constexpr uint32 SplineLibraryVersion = 2;
+
+// Sample blocks and their rotations start on this boundary, FQuat4f is read in place and is declared alignas(16)
+static constexpr uint64 SplineLibrarySampleAlignment = 16;
+
+struct FSplineLibraryHeader
+{
+    uint32 Magic;
+    uint32 Version;
+    uint32 NumSplines;
+    uint32 Reserved;
+};
+
+static_assert(sizeof(FSplineLibraryHeader) == 16, "Spline library header layout changed");
+static_assert(sizeof(FSplineLibraryEntry) == 40, "Spline library entry layout changed");
+
+// Offset of the rotations inside a sample block, the locations before them are padded to the alignment
+static int64 GetRotationsOffset(uint32 NumSamples)
+{
+    return Align(static_cast<int64>(NumSamples) * sizeof(FVector3f), SplineLibrarySampleAlignment);
+}
+
+static int64 GetSamplesSize(uint32 NumSamples)
+{
+    return GetRotationsOffset(NumSamples) + static_cast<int64>(NumSamples) * sizeof(FQuat4f);
+}
+
+FSplineLibrary::FSplineLibrary() = default;
+
+FSplineLibrary::~FSplineLibrary()
+{
+    // Regions have to be unmapped before their file
+    MappedIndex.Reset();
+    MappedFile.Reset();
+}
+
+bool FSplineLibrary::Write(const FString& Filename, TConstArrayView<const USplineComponent*> Splines, float SampleSpacing, float MaxError)
+{
+    TArray<FSplineLibraryEntry> Entries;
+    TArray<uint8> Samples;
+
+    for (const USplineComponent* Spline : Splines)
+    {
+        if (!Spline)
+        {
+            continue;
+        }
+
+        FSplineDistanceTable Table;
+        Table.Build(*Spline, SampleSpacing, MaxError);
+
+        const FTransform ComponentToWorld = Spline->GetComponentTransform();
+        const int32 NumSamples = Table.GetLocations().Num();
+
+        TArray<FVector3f> Locations;
+        TArray<FQuat4f> Rotations;
+        Locations.Reserve(NumSamples);
+        Rotations.Reserve(NumSamples);
+
+        FBox3f Bounds(ForceInit);
+        for (int32 i = 0; i < NumSamples; ++i)
+        {
+            const FVector3f Location(ComponentToWorld.TransformPosition(Table.GetLocations()[i]));
+            Locations.Add(Location);
+            Rotations.Add(FQuat4f(ComponentToWorld.TransformRotation(Table.GetRotations()[i])));
+            Bounds += Location;
+        }
+
+        FSplineLibraryEntry& Entry = Entries.AddZeroed_GetRef();
+        Entry.BoundsMin = Bounds.Min;
+        Entry.BoundsMax = Bounds.Max;
+        Entry.SplineLength = Table.GetSplineLength();
+        Entry.NumSamples = NumSamples;
+
+        // Offsets are relative to the sample block until the index size is known
+        Entry.SamplesOffset = Samples.Num();
+        Samples.Append(reinterpret_cast<const uint8*>(Locations.GetData()), Locations.Num() * sizeof(FVector3f));
+        Samples.SetNumZeroed(static_cast<int32>(Entry.SamplesOffset + GetRotationsOffset(NumSamples)));
+        Samples.Append(reinterpret_cast<const uint8*>(Rotations.GetData()), Rotations.Num() * sizeof(FQuat4f));
+    }
+
+    // Blocks are whole multiples of the alignment, so aligning their start aligns all of them
+    const uint64 IndexEnd = sizeof(FSplineLibraryHeader) + Entries.Num() * sizeof(FSplineLibraryEntry);
+    const uint64 SamplesStart = Align(IndexEnd, SplineLibrarySampleAlignment);
+    for (FSplineLibraryEntry& Entry : Entries)
+    {
+        Entry.SamplesOffset += SamplesStart;
+    }
+
+    FSplineLibraryHeader Header;
+    Header.Magic = SplineLibraryMagic;
+    Header.Version = SplineLibraryVersion;
+    Header.NumSplines = Entries.Num();
+    Header.Reserved = 0;
+
+    TArray<uint8> Data;
+    Data.Reserve(SamplesStart + Samples.Num());
+    Data.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+    Data.Append(reinterpret_cast<const uint8*>(Entries.GetData()), Entries.Num() * sizeof(FSplineLibraryEntry));
+    Data.SetNumZeroed(static_cast<int32>(SamplesStart));
+    Data.Append(Samples);
+
+    if (!FFileHelper::SaveArrayToFile(Data, *Filename))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to write spline library %s."), *Filename);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Wrote %d splines to spline library %s."), Entries.Num(), *Filename);
+    return true;
+}
+
+TSharedPtr<FSplineLibrary> FSplineLibrary::Open(const FString& Filename)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    TSharedPtr<FSplineLibrary> Library = MakeShareable(new FSplineLibrary());
+    Library->Filename = Filename;
+
+    const int64 FileSize = PlatformFile.FileSize(*Filename);
+    if (FileSize < static_cast<int64>(sizeof(FSplineLibraryHeader)))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Spline library %s is missing or truncated."), *Filename);
+        return nullptr;
+    }
+
+    FSplineLibraryHeader Header;
+    Library->MappedFile.Reset(PlatformFile.OpenMapped(*Filename));
+
+    if (Library->MappedFile)
+    {
+        TUniquePtr<IMappedFileRegion> HeaderRegion(Library->MappedFile->MapRegion(0, sizeof(FSplineLibraryHeader)));
+        if (!HeaderRegion)
+        {
+            return nullptr;
+        }
+        FMemory::Memcpy(&Header, HeaderRegion->GetMappedPtr(), sizeof(Header));
+    }
+    else
+    {
+        // No memory mapping on this platform, stream the index and the samples instead
+        Library->StreamedFile.Reset(PlatformFile.OpenRead(*Filename));
+        if (!Library->StreamedFile || !Library->StreamedFile->Read(reinterpret_cast<uint8*>(&Header), sizeof(Header)))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Failed to open spline library %s."), *Filename);
+            return nullptr;
+        }
+    }
+
+    const int64 IndexSize = sizeof(FSplineLibraryHeader) + static_cast<int64>(Header.NumSplines) * sizeof(FSplineLibraryEntry);
+    if (Header.Magic != SplineLibraryMagic || Header.Version != SplineLibraryVersion || IndexSize > FileSize)
+    {
+        UE_LOG(LogTemp, Error, TEXT("%s is not a spline library of version %u."), *Filename, SplineLibraryVersion);
+        return nullptr;
+    }
+
+    if (Library->MappedFile)
+    {
+        Library->MappedIndex.Reset(Library->MappedFile->MapRegion(0, IndexSize));
+        if (!Library->MappedIndex)
+        {
+            return nullptr;
+        }
+        Library->Entries = reinterpret_cast<const FSplineLibraryEntry*>(Library->MappedIndex->GetMappedPtr() + sizeof(FSplineLibraryHeader));
+    }
+    else
+    {
+        Library->IndexBuffer.SetNumUninitialized(IndexSize - sizeof(FSplineLibraryHeader));
+        if (!Library->StreamedFile->Read(Library->IndexBuffer.GetData(), Library->IndexBuffer.Num()))
+        {
+            return nullptr;
+        }
+        Library->Entries = reinterpret_cast<const FSplineLibraryEntry*>(Library->IndexBuffer.GetData());
+    }
+
+    // Reject entries pointing outside the file once, so acquiring never has to
+    for (uint32 i = 0; i < Header.NumSplines; ++i)
+    {
+        const FSplineLibraryEntry& Entry = Library->Entries[i];
+        if (Entry.NumSamples < 2 || !IsAligned(Entry.SamplesOffset, SplineLibrarySampleAlignment)
+            || Entry.SamplesOffset + GetSamplesSize(Entry.NumSamples) > static_cast<uint64>(FileSize))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Spline library %s has a corrupt entry %u."), *Filename, i);
+            return nullptr;
+        }
+    }
+
+    Library->NumSplines = Header.NumSplines;
+    return Library;
+}
+
+FBox FSplineLibrary::GetBounds(int32 SplineIndex) const
+{
+    check(SplineIndex >= 0 && SplineIndex < NumSplines);
+
+    const FSplineLibraryEntry& Entry = Entries[SplineIndex];
+    return FBox(FVector(Entry.BoundsMin), FVector(Entry.BoundsMax));
+}
+
+void FSplineLibrary::FindSplinesInBox(const FBox& Box, TArray<int32>& OutSplineIndices) const
+{
+    const FBox3f QueryBox(Box);
+
+    for (int32 i = 0; i < NumSplines; ++i)
+    {
+        if (QueryBox.Intersect(FBox3f(Entries[i].BoundsMin, Entries[i].BoundsMax)))
+        {
+            OutSplineIndices.Add(i);
+        }
+    }
+}
+
+TSharedPtr<const FSplineDistanceTable> FSplineLibrary::AcquireTable(int32 SplineIndex)
+{
+    if (SplineIndex < 0 || SplineIndex >= NumSplines)
+    {
+        return nullptr;
+    }
+
+    TWeakPtr<const FSplineDistanceTable>& ResidentTable = ResidentTables.FindOrAdd(SplineIndex);
+    if (TSharedPtr<const FSplineDistanceTable> Table = ResidentTable.Pin())
+    {
+        return Table;
+    }
+
+    const FSplineLibraryEntry& Entry = Entries[SplineIndex];
+
+    FSplineLibrarySampleBuffer Buffer;
+    TUniquePtr<IMappedFileRegion> Region;
+    const uint8* Samples = nullptr;
+
+    if (MappedFile)
+    {
+        // Only this spline's pages are touched, the region is unmapped again once decoded
+        Region.Reset(MappedFile->MapRegion(Entry.SamplesOffset, GetSamplesSize(Entry.NumSamples)));
+        Samples = Region ? Region->GetMappedPtr() : nullptr;
+    }
+    else
+    {
+        ReadSamples(Entry, Buffer, Samples);
+    }
+
+    if (!Samples)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to read spline %d from spline library %s."), SplineIndex, *Filename);
+        return nullptr;
+    }
+
+    const TConstArrayView<FVector3f> Locations(reinterpret_cast<const FVector3f*>(Samples), Entry.NumSamples);
+    const TConstArrayView<FQuat4f> Rotations(reinterpret_cast<const FQuat4f*>(Samples + GetRotationsOffset(Entry.NumSamples)), Entry.NumSamples);
+    check(IsAligned(Rotations.GetData(), alignof(FQuat4f)));
+
+    TSharedPtr<FSplineDistanceTable> Table = MakeShared<FSplineDistanceTable>();
+    Table->InitFromSamples(Locations, Rotations, Entry.SplineLength);
+
+    ResidentTable = Table;
+    return Table;
+}
+
+bool FSplineLibrary::ReadSamples(const FSplineLibraryEntry& Entry, FSplineLibrarySampleBuffer& OutBuffer, const uint8*& OutSamples)
+{
+    OutBuffer.SetNumUninitialized(GetSamplesSize(Entry.NumSamples));
+
+    if (!StreamedFile->Seek(Entry.SamplesOffset) || !StreamedFile->Read(OutBuffer.GetData(), OutBuffer.Num()))
+    {
+        return false;
+    }
+
+    OutSamples = OutBuffer.GetData();
+    return true;
+}
+
+int32 FSplineLibrary::GetNumResidentSplines() const
+{
+    int32 NumResident = 0;
+    for (const TPair<int32, TWeakPtr<const FSplineDistanceTable>>& ResidentTable : ResidentTables)
+    {
+        NumResident += ResidentTable.Value.IsValid() ? 1 : 0;
+    }
+
+    return NumResident;
+}
@@ -0,0 +1,54 @@
+#include "SplineLibrarySubsystem.h"
+#include "Components/SplineComponent.h"
+
+bool USplineLibrarySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USplineLibrarySubsystem::Deinitialize()
+{
+    Library.Reset();
+
+    Super::Deinitialize();
+}
+
+bool USplineLibrarySubsystem::OpenLibrary(const FString& Filename)
+{
+    TSharedPtr<FSplineLibrary> OpenedLibrary = FSplineLibrary::Open(Filename);
+    if (!OpenedLibrary)
+    {
+        return false;
+    }
+
+    Library = OpenedLibrary;
+    OnLibraryChanged.Broadcast();
+    return true;
+}
+
+bool USplineLibrarySubsystem::WriteLibrary(const FString& Filename, const TArray<USplineComponent*>& Splines, float SampleSpacing, float MaxError)
+{
+    TArray<const USplineComponent*> ConstSplines(Splines);
+    return FSplineLibrary::Write(Filename, ConstSplines, SampleSpacing, MaxError);
+}
+
+int32 USplineLibrarySubsystem::GetNumLibrarySplines() const
+{
+    return Library ? Library->Num() : 0;
+}
+
+TArray<int32> USplineLibrarySubsystem::FindSplinesInBox(const FBox& Box) const
+{
+    TArray<int32> SplineIndices;
+    if (Library)
+    {
+        Library->FindSplinesInBox(Box, SplineIndices);
+    }
+
+    return SplineIndices;
+}
+
+TSharedPtr<const FSplineDistanceTable> USplineLibrarySubsystem::AcquireSplineTable(int32 SplineIndex)
+{
+    return Library ? Library->AcquireTable(SplineIndex) : nullptr;
+}
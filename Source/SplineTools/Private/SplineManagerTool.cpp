@@ -2,18 +2,42 @@
 #include "Engine/Selection.h"
 #include "Kismet/GameplayStatics.h"
 #include "EngineUtils.h"
-#include "TimerManager.h"
 #include "Engine/World.h"
+#include "Engine/Level.h"
+#include "SplineLibrary.h"
+#include "SplineCurveCopy.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Count.h"
 #if WITH_EDITOR
 #include "Editor.h"
+#include "ScopedTransaction.h"
+#include "Misc/TransactionObjectEvent.h"
 #endif
 
+// Below this many target splines the copies are built on the game thread
+static constexpr int32 ParallelPropagationThreshold = 8;
+
+// Actors that went away without an OnLevelActorDeleted notification, e.g. an undone placement
+template<typename T>
+static void RemoveStaleActors(TSet<TWeakObjectPtr<T>>& Actors)
+{
+    for (auto It = Actors.CreateIterator(); It; ++It)
+    {
+        if (!It->IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
 // Initialize static instance
 USplineManagerTool* USplineManagerTool::Instance = nullptr;
 
 // Constructor
 USplineManagerTool::USplineManagerTool()
     : CurrentGlobalSplineActor(nullptr)
+    , CurrentGlobalSplineCharacter(nullptr)
+    , bHasModifications(false)
 {
 }
 
@@ -45,9 +69,14 @@ USplineManagerTool* USplineManagerTool::GetInstance()
     return Instance;
 }
 
-// Initialize and subscribe to selection change events
+// Initialize and subscribe to selection change events, only the first call scans the world
 void USplineManagerTool::Initialize()
 {
+    if (bIsInitialized)
+    {
+        return;
+    }
+
     UWorld* World = GEditor->GetEditorWorldContext().World();
     if (!World || !World->IsValidLowLevel())
     {
@@ -62,19 +91,91 @@ void USplineManagerTool::Initialize()
     FEditorDelegates::EndPIE.AddUObject(this, &USplineManagerTool::OnLevelChanged);
     FEditorDelegates::OnMapOpened.AddUObject(this, &USplineManagerTool::OnLevelChanged);
 
-    // Populate tracked splines and set up the timer
-    for (TActorIterator<ASplineTrackerActor> It(World); It; ++It)
+    // Propagate when a global spline is actually edited instead of polling
+    FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &USplineManagerTool::OnObjectPropertyChanged);
+
+    // Undo and redo restore tags without a property change notification naming them
+    FCoreUObjectDelegates::OnObjectTransacted.AddUObject(this, &USplineManagerTool::OnObjectTransacted);
+
+    // Keep the tracked actors in sync instead of scanning the world again
+    GEngine->OnLevelActorAdded().AddUObject(this, &USplineManagerTool::TrackActor);
+    GEngine->OnLevelActorDeleted().AddUObject(this, &USplineManagerTool::UntrackActor);
+    FWorldDelegates::LevelAddedToWorld.AddUObject(this, &USplineManagerTool::OnLevelAddedToWorld);
+    FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &USplineManagerTool::OnLevelRemovedFromWorld);
+
+    // Populate tracked splines
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        TrackActor(*It);
+    }
+
+    bIsInitialized = true;
+    UE_LOG(LogTemp, Log, TEXT("Spline Manager Tool Initialized with %d splines and %d characters."), GetNumTrackedSplines(), GetNumTrackedCharacters());
+}
+
+void USplineManagerTool::TrackActor(AActor* Actor)
+{
+    // Actors added to PIE, preview or other worlds are not propagated to
+    if (!Actor || !GEditor || Actor->GetWorld() != GEditor->GetEditorWorldContext().World())
     {
-        AllTrackedSplines.Add(*It);
+        return;
     }
 
-    for (TActorIterator<ASplineCharacterFollower> It(World); It; ++It)
+    if (ASplineTrackerActor* SplineActor = Cast<ASplineTrackerActor>(Actor))
     {
-        AllTrackedCharacters.Add(*It);
+        AllTrackedSplines.Add(SplineActor);
+        SplineGroups.Add(SplineActor);
     }
+    else if (ASplineCharacterFollower* SplineCharacter = Cast<ASplineCharacterFollower>(Actor))
+    {
+        AllTrackedCharacters.Add(SplineCharacter);
+        CharacterGroups.Add(SplineCharacter);
+    }
+}
 
-    World->GetTimerManager().SetTimer(UpdateTimerHandle, this, &USplineManagerTool::CheckForSplineUpdates, 0.5f, true, 1.0f);
-    UE_LOG(LogTemp, Log, TEXT("Spline Manager Tool Initialized with periodic updates."));
+void USplineManagerTool::UntrackActor(AActor* Actor)
+{
+    if (ASplineTrackerActor* SplineActor = Cast<ASplineTrackerActor>(Actor))
+    {
+        AllTrackedSplines.Remove(SplineActor);
+        SplineGroups.Remove(SplineActor);
+        if (CurrentGlobalSplineActor == SplineActor)
+        {
+            CurrentGlobalSplineActor = nullptr;
+        }
+    }
+    else if (ASplineCharacterFollower* SplineCharacter = Cast<ASplineCharacterFollower>(Actor))
+    {
+        AllTrackedCharacters.Remove(SplineCharacter);
+        CharacterGroups.Remove(SplineCharacter);
+        if (CurrentGlobalSplineCharacter == SplineCharacter)
+        {
+            CurrentGlobalSplineCharacter = nullptr;
+        }
+    }
+}
+
+// Streamed or sub levels of the editor world bring their own actors
+void USplineManagerTool::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+    if (Level && GEditor && World == GEditor->GetEditorWorldContext().World())
+    {
+        for (AActor* Actor : Level->Actors)
+        {
+            TrackActor(Actor);
+        }
+    }
+}
+
+void USplineManagerTool::OnLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+    if (Level && GEditor && World == GEditor->GetEditorWorldContext().World())
+    {
+        for (AActor* Actor : Level->Actors)
+        {
+            UntrackActor(Actor);
+        }
+    }
 }
 
 void USplineManagerTool::OnLevelChanged()
@@ -104,18 +205,29 @@ void USplineManagerTool::Shutdown()
     {
         GEditor->GetSelectedActors()->SelectObjectEvent.RemoveAll(this);
 
-        if (UWorld* World = GEditor->GetEditorWorldContext().World())
-        {
-            World->GetTimerManager().ClearTimer(UpdateTimerHandle);
-        }
-
         // Unregister from level change events
         FEditorDelegates::PreBeginPIE.RemoveAll(this);
         FEditorDelegates::EndPIE.RemoveAll(this);
         FEditorDelegates::OnMapOpened.RemoveAll(this);
     }
 
+    FCoreUObjectDelegates::OnObjectPropertyChanged.RemoveAll(this);
+    FCoreUObjectDelegates::OnObjectTransacted.RemoveAll(this);
+
+    if (GEngine)
+    {
+        GEngine->OnLevelActorAdded().RemoveAll(this);
+        GEngine->OnLevelActorDeleted().RemoveAll(this);
+    }
+
+    FWorldDelegates::LevelAddedToWorld.RemoveAll(this);
+    FWorldDelegates::LevelRemovedFromWorld.RemoveAll(this);
+
     AllTrackedSplines.Empty();
+    AllTrackedCharacters.Empty();
+    SplineGroups.Reset();
+    CharacterGroups.Reset();
+    bIsInitialized = false;
 
     if (Instance)
     {
@@ -133,7 +245,7 @@ void USplineManagerTool::OnSelectionChanged(UObject* NewSelection)
         {
             UE_LOG(LogTemp, Log, TEXT("Selected Global Spline: %s"), *SelectedSplineActor->GetName());
             CurrentGlobalSplineActor = SelectedSplineActor;
-            ApplyGlobalSplineToAllSplines(CurrentGlobalSplineActor);
+            ApplyGlobalSplineToAllSplines(SelectedSplineActor);
             bHasModifications = true;
         }
         else
@@ -145,7 +257,7 @@ void USplineManagerTool::OnSelectionChanged(UObject* NewSelection)
         if (SelectedSplineCharacter->bGlobalOverride) {
             UE_LOG(LogTemp, Log, TEXT("Selected Global Spline: %s"), *SelectedSplineCharacter->GetName());
             CurrentGlobalSplineCharacter = SelectedSplineCharacter;
-            ApplyGlobalSplineToAllSplines(CurrentGlobalSplineCharacter);
+            ApplyGlobalSplineToAllSplines(SelectedSplineCharacter);
             bHasModifications = true;
         }
         else
@@ -157,45 +269,124 @@ void USplineManagerTool::OnSelectionChanged(UObject* NewSelection)
     {
         // Deselecting the spline actor, stop any updates
         CurrentGlobalSplineActor = nullptr;
+        CurrentGlobalSplineCharacter = nullptr;
         bHasModifications = false; // Reset modifications
-        if (UWorld* World = GEditor->GetEditorWorldContext().World())
-        {
-            World->GetTimerManager().ClearTimer(UpdateTimerHandle);
-        }
+    }
+}
+
+// Called for every property change in the editor, only edits of a global spline propagate
+void USplineManagerTool::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+    if (bIsPropagating || !Object)
+    {
+        return;
+    }
+
+    // Keep the groups in sync with tag edits of any tracked actor, editing a single tag reports the tag element
+    // as the property and Tags as the member property
+    if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(AActor, Tags))
+    {
+        RegroupActor(Object);
+    }
+
+    if (!bHasModifications)
+    {
+        return;
+    }
+
+    const AActor* Owner = Object->IsA<AActor>() ? Cast<AActor>(Object) : Object->GetTypedOuter<AActor>();
+    if (Owner && (Owner == CurrentGlobalSplineActor.Get() || Owner == CurrentGlobalSplineCharacter.Get()))
+    {
+        CheckForSplineUpdates();
+    }
+}
+
+void USplineManagerTool::OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& TransactionEvent)
+{
+    if (Object && TransactionEvent.GetEventType() == ETransactionObjectEventType::UndoRedo)
+    {
+        RegroupActor(Object);
+    }
+}
+
+void USplineManagerTool::RegroupActor(UObject* Object)
+{
+    if (ASplineTrackerActor* SplineActor = Cast<ASplineTrackerActor>(Object))
+    {
+        SplineGroups.Regroup(SplineActor);
+    }
+    else if (ASplineCharacterFollower* SplineCharacter = Cast<ASplineCharacterFollower>(Object))
+    {
+        CharacterGroups.Regroup(SplineCharacter);
     }
 }
 
 // Check for updates in spline positions
 void USplineManagerTool::CheckForSplineUpdates()
 {
-    UWorld* World = GEditor->GetEditorWorldContext().World();
-    if (!World || !World->IsValidLowLevel()) // Verify World is still valid
+    if (ASplineTrackerActor* GlobalSplineActor = CurrentGlobalSplineActor.Get(); GlobalSplineActor && bHasModifications)
     {
-        UE_LOG(LogTemp, Warning, TEXT("World context is invalid in CheckForSplineUpdates."));
-        return;
+        const uint32 Hash = HashSplinePoints(GlobalSplineActor->SplineComponent);
+        if (Hash != LastGlobalSplineHash)
+        {
+            ApplyGlobalSplineToAllSplines(GlobalSplineActor);
+        }
     }
 
-    if (CurrentGlobalSplineActor && bHasModifications)
+    if (ASplineCharacterFollower* GlobalSplineCharacter = CurrentGlobalSplineCharacter.Get(); GlobalSplineCharacter && bHasModifications)
     {
-        ApplyGlobalSplineToAllSplines(CurrentGlobalSplineActor);
+        const uint32 Hash = HashSplinePoints(GlobalSplineCharacter->SplineComponent);
+        if (Hash != LastGlobalCharacterHash)
+        {
+            ApplyGlobalSplineToAllSplines(GlobalSplineCharacter);
+        }
     }
-    else
+}
+
+uint32 USplineManagerTool::HashSplinePoints(const USplineComponent* Spline)
+{
+    if (!Spline)
     {
-        World->GetTimerManager().ClearTimer(UpdateTimerHandle);
+        return 0;
     }
 
-    if (CurrentGlobalSplineCharacter && bHasModifications)
+    const FSplineCurves& Curves = Spline->SplineCurves;
+    uint32 Hash = GetTypeHash(Curves.Position.Points.Num());
+
+    // Field by field, the curve points have padding
+    for (const FInterpCurvePoint<FVector>& Point : Curves.Position.Points)
     {
-        ApplyGlobalSplineToAllSplines(CurrentGlobalSplineCharacter);
+        Hash = HashCombine(Hash, GetTypeHash(Point.InVal));
+        Hash = HashCombine(Hash, GetTypeHash(Point.OutVal));
+        Hash = HashCombine(Hash, GetTypeHash(Point.ArriveTangent));
+        Hash = HashCombine(Hash, GetTypeHash(Point.LeaveTangent));
+        Hash = HashCombine(Hash, GetTypeHash(Point.InterpMode.GetValue()));
     }
-    else
+
+    for (const FInterpCurvePoint<FQuat>& Point : Curves.Rotation.Points)
+    {
+        Hash = HashCombine(Hash, GetTypeHash(Point.OutVal));
+    }
+
+    for (const FInterpCurvePoint<FVector>& Point : Curves.Scale.Points)
     {
-        World->GetTimerManager().ClearTimer(UpdateTimerHandle);
+        Hash = HashCombine(Hash, GetTypeHash(Point.OutVal));
     }
+
+    return Hash;
 }
 
+// Copy of the global spline for one target, built off the game thread
+struct FPendingSplineCopy
+{
+    USplineComponent* Spline = nullptr;
+    FSplineCurveBakeSettings Settings;
+    FSplineCurves Curves;
+    bool bChanged = false;
+};
+
 template <typename T>
-void USplineManagerTool::ApplyGlobalSpline(T* SourceSpline, TArray<T*>& TrackedSplines)
+void USplineManagerTool::ApplyGlobalSpline(T* SourceSpline, const TSplineTrackerGroups<T>& TrackedGroups)
 {
     if (!SourceSpline || !SourceSpline->SplineComponent)
     {
@@ -203,26 +394,30 @@ void USplineManagerTool::ApplyGlobalSpline(T* SourceSpline, TArray<T*>& TrackedS
         return;
     }
 
-    const int32 PointCount = SourceSpline->SplineComponent->GetNumberOfSplinePoints();
-    UE_LOG(LogTemp, Log, TEXT("Copying %d points from global spline to others."), PointCount);
+    const FSplineCurves& SourceCurves = SourceSpline->SplineComponent->SplineCurves;
+    const FSplineCurveBakeSettings SourceSettings(*SourceSpline->SplineComponent);
+    UE_LOG(LogTemp, Log, TEXT("Copying %d points from global spline to others."), SourceCurves.Position.Points.Num());
+
+    const TArray<TWeakObjectPtr<T>>* Group = TrackedGroups.Find(SourceSpline);
+    if (!Group)
+    {
+        return;
+    }
 
-    for (T* Spline : TrackedSplines)
+    TArray<FPendingSplineCopy> Copies;
+    for (const TWeakObjectPtr<T>& TrackedSpline : *Group)
     {
-        if (Spline && Spline->bGlobalOverride && Spline != SourceSpline &&
+        T* Spline = TrackedSpline.Get();
+        if (IsValid(Spline) && Spline->bGlobalOverride && Spline != SourceSpline &&
             Spline->GetClass() == SourceSpline->GetClass() &&
             Spline->Tags == SourceSpline->Tags)
         {
             USplineComponent* TargetSpline = Spline->SplineComponent;
-            if (TargetSpline)
+            if (IsValid(TargetSpline))
             {
-                TargetSpline->ClearSplinePoints();
-
-                for (int32 i = 0; i < PointCount; ++i)
-                {
-                    FVector Position = SourceSpline->SplineComponent->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::Local);
-                    TargetSpline->AddSplinePoint(Position, ESplineCoordinateSpace::Local, true);
-                }
-                TargetSpline->UpdateSpline();
+                FPendingSplineCopy& Copy = Copies.AddDefaulted_GetRef();
+                Copy.Spline = TargetSpline;
+                Copy.Settings = FSplineCurveBakeSettings(*TargetSpline);
             }
             else
             {
@@ -230,15 +425,72 @@ void USplineManagerTool::ApplyGlobalSpline(T* SourceSpline, TArray<T*>& TrackedS
             }
         }
     }
+
+    // Diff and copy the curves of every target in parallel, the components are only read here.
+    // Targets keep their own closed loop and reparam settings, the source's table is reused where they match
+    ParallelFor(Copies.Num(), [&Copies, &SourceCurves, &SourceSettings](int32 i)
+    {
+        FPendingSplineCopy& Copy = Copies[i];
+        if (Copy.Spline->SplineCurves == SourceCurves)
+        {
+            // Already has the same curves
+            return;
+        }
+
+        FSplineCurveCopy::CopyCurves(SourceCurves, SourceSettings, Copy.Curves, Copy.Settings);
+        Copy.bChanged = true;
+    }, Copies.Num() < ParallelPropagationThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+    const int32 NumChanged = Algo::CountIf(Copies, [](const FPendingSplineCopy& Copy) { return Copy.bChanged; });
+    if (NumChanged == 0)
+    {
+        return;
+    }
+
+    TGuardValue<bool> PropagationGuard(bIsPropagating, true);
+
+    // One undo step for the whole propagation
+    const FScopedTransaction Transaction(FText::Format(NSLOCTEXT("SplineTools", "PropagateGlobalSpline", "Propagate Global Spline to {0} Splines"), NumChanged));
+
+    for (FPendingSplineCopy& Copy : Copies)
+    {
+        if (Copy.bChanged)
+        {
+            // Bumps the target's own version, cached tables of the old curves must not match the copied one
+            Copy.Spline->Modify();
+            FSplineCurveCopy::AssignCurves(*Copy.Spline, MoveTemp(Copy.Curves));
+        }
+    }
 }
 
 void USplineManagerTool::ApplyGlobalSplineToAllSplines(ASplineTrackerActor* SourceSplineActor)
 {
-    ApplyGlobalSpline(SourceSplineActor, AllTrackedSplines);
+    RemoveStaleActors(AllTrackedSplines);
+    SplineGroups.RemoveStale();
+    ApplyGlobalSpline(SourceSplineActor, SplineGroups);
+    LastGlobalSplineHash = SourceSplineActor ? HashSplinePoints(SourceSplineActor->SplineComponent) : 0;
 }
 
 void USplineManagerTool::ApplyGlobalSplineToAllSplines(ASplineCharacterFollower* SourceSplineCharacter)
 {
-    ApplyGlobalSpline(SourceSplineCharacter, AllTrackedCharacters);
+    RemoveStaleActors(AllTrackedCharacters);
+    CharacterGroups.RemoveStale();
+    ApplyGlobalSpline(SourceSplineCharacter, CharacterGroups);
+    LastGlobalCharacterHash = SourceSplineCharacter ? HashSplinePoints(SourceSplineCharacter->SplineComponent) : 0;
+}
+
+bool USplineManagerTool::ExportSplineLibrary(const FString& Filename, float SampleSpacing, float MaxError) const
+{
+    TArray<const USplineComponent*> Splines;
+    for (const TWeakObjectPtr<ASplineTrackerActor>& TrackedSpline : AllTrackedSplines)
+    {
+        const ASplineTrackerActor* SplineActor = TrackedSpline.Get();
+        if (IsValid(SplineActor) && IsValid(SplineActor->SplineComponent))
+        {
+            Splines.Add(SplineActor->SplineComponent);
+        }
+    }
+
+    return FSplineLibrary::Write(Filename, Splines, SampleSpacing, MaxError);
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "SplineMovementComponent.h"
+#include "GameFramework/Character.h"
+
+void USplineMovementComponent::SetOnRails(bool bOnRails)
+{
+    if (bOnRails == IsOnRails())
+    {
+        return;
+    }
+
+    if (bOnRails)
+    {
+        SetMovementMode(MOVE_Custom, static_cast<uint8>(ESplineCustomMovementMode::Rails));
+    }
+    else
+    {
+        SetDefaultMovementMode();
+    }
+}
+
+bool USplineMovementComponent::IsOnRails() const
+{
+    return MovementMode == MOVE_Custom && CustomMovementMode == static_cast<uint8>(ESplineCustomMovementMode::Rails);
+}
+
+void USplineMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
+{
+    Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+
+    const bool bOnRails = IsOnRails();
+
+    // Nothing is simulated on rails, the owner moves the character
+    SetComponentTickEnabled(!bOnRails);
+
+    // The follow state replaces the replicated movement while on rails
+    if (CharacterOwner && CharacterOwner->HasAuthority())
+    {
+        CharacterOwner->SetReplicateMovement(!bOnRails);
+    }
+
+    if (bOnRails)
+    {
+        Velocity = FVector::ZeroVector;
+        CurrentFloor.Clear();
+    }
+}
+
+void USplineMovementComponent::MoveAlongSpline(const FVector& NewLocation, const FQuat& NewRotation, float DeltaTime, ETeleportType Teleport)
+{
+    if (!UpdatedComponent)
+    {
+        return;
+    }
+
+    const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+    UpdatedComponent->MoveComponent(NewLocation - OldLocation, NewRotation, false, nullptr, MOVECOMP_NoFlags, Teleport);
+
+    // Teleports keep the last velocity instead of reporting the jump
+    if (Teleport == ETeleportType::None && DeltaTime > KINDA_SMALL_NUMBER)
+    {
+        Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / DeltaTime;
+    }
+
+    UpdateComponentVelocity();
+}
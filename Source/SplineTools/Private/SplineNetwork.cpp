@@ -0,0 +1,502 @@
+#include "SplineNetwork.h"
+#include "SplineTrackerActor.h"
+#include "Components/SplineComponent.h"
+#include "Algo/Reverse.h"
+
+ASplineNetwork::ASplineNetwork()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void ASplineNetwork::BeginPlay()
+{
+    Super::BeginPlay();
+
+    RebuildGraph();
+}
+
+void ASplineNetwork::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    ClearRouteSplines();
+    PathTrees.Empty();
+
+    // Without junctions no route spline can be handed out again, followers fall back to their own splines
+    NodeLocations.Empty();
+    Edges.Empty();
+    NodeFirstEdges.Empty();
+    BuiltSplines.Empty();
+    BuiltSplineVersions.Empty();
+    OnGraphChanged.Broadcast();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ASplineNetwork::RebuildGraph()
+{
+    ClearRouteSplines();
+    PathTrees.Empty();
+
+    TArray<TArray<int32>> PointNodes;
+    BuildNodes(PointNodes);
+    BuildEdges(PointNodes);
+
+    BuiltSplines.Reset();
+    BuiltSplineVersions.Reset();
+    for (const ASplineTrackerActor* SplineActor : Splines)
+    {
+        if (IsValid(SplineActor) && IsValid(SplineActor->SplineComponent))
+        {
+            BuiltSplines.Add(SplineActor->SplineComponent);
+            BuiltSplineVersions.Add(SplineActor->SplineComponent->SplineCurves.Version);
+        }
+    }
+
+    ++GraphVersion;
+
+    UE_LOG(LogTemp, Log, TEXT("%s: built %d junctions and %d edges from %d splines."), *GetName(), NodeLocations.Num(), Edges.Num(), Splines.Num());
+
+    OnGraphChanged.Broadcast();
+}
+
+// Join close spline points into nodes and keep the ones that are junctions
+void ASplineNetwork::BuildNodes(TArray<TArray<int32>>& OutPointNodes)
+{
+    const float Tolerance = FMath::Max(JunctionTolerance, 0.1f);
+    const float ToleranceSquared = FMath::Square(Tolerance);
+
+    // Candidate nodes hashed by grid cell, a point only has to look at the neighbouring cells
+    TArray<FVector> CandidateLocations;
+    TArray<int32> CandidateUseCounts;
+    TMap<FIntVector, TArray<int32>> Cells;
+
+    OutPointNodes.SetNum(Splines.Num());
+
+    for (int32 SplineIndex = 0; SplineIndex < Splines.Num(); ++SplineIndex)
+    {
+        const USplineComponent* Spline = IsValid(Splines[SplineIndex]) ? Splines[SplineIndex]->SplineComponent : nullptr;
+        const int32 NumPoints = IsValid(Spline) ? Spline->GetNumberOfSplinePoints() : 0;
+        OutPointNodes[SplineIndex].Init(INDEX_NONE, NumPoints);
+
+        for (int32 Point = 0; Point < NumPoints; ++Point)
+        {
+            const FVector Location = Spline->GetLocationAtSplinePoint(Point, ESplineCoordinateSpace::World);
+            const FIntVector Cell(FMath::FloorToInt(Location.X / Tolerance), FMath::FloorToInt(Location.Y / Tolerance), FMath::FloorToInt(Location.Z / Tolerance));
+
+            int32 Candidate = INDEX_NONE;
+            for (int32 X = -1; X <= 1 && Candidate == INDEX_NONE; ++X)
+            {
+                for (int32 Y = -1; Y <= 1 && Candidate == INDEX_NONE; ++Y)
+                {
+                    for (int32 Z = -1; Z <= 1 && Candidate == INDEX_NONE; ++Z)
+                    {
+                        if (const TArray<int32>* CellCandidates = Cells.Find(Cell + FIntVector(X, Y, Z)))
+                        {
+                            for (int32 CellCandidate : *CellCandidates)
+                            {
+                                if (FVector::DistSquared(CandidateLocations[CellCandidate], Location) <= ToleranceSquared)
+                                {
+                                    Candidate = CellCandidate;
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (Candidate == INDEX_NONE)
+            {
+                Candidate = CandidateLocations.Add(Location);
+                CandidateUseCounts.Add(0);
+                Cells.FindOrAdd(Cell).Add(Candidate);
+            }
+
+            ++CandidateUseCounts[Candidate];
+            OutPointNodes[SplineIndex][Point] = Candidate;
+        }
+    }
+
+    // Shared points and the ends of open splines become junctions, loops without any get one at their first point
+    TArray<bool> IsJunction;
+    IsJunction.Init(false, CandidateLocations.Num());
+
+    for (int32 SplineIndex = 0; SplineIndex < Splines.Num(); ++SplineIndex)
+    {
+        TArray<int32>& Nodes = OutPointNodes[SplineIndex];
+        if (Nodes.Num() == 0)
+        {
+            continue;
+        }
+
+        const bool bClosedLoop = Splines[SplineIndex]->SplineComponent->IsClosedLoop();
+        bool bHasJunction = false;
+
+        for (int32 Point = 0; Point < Nodes.Num(); ++Point)
+        {
+            const bool bEnd = !bClosedLoop && (Point == 0 || Point == Nodes.Num() - 1);
+            if (bEnd || CandidateUseCounts[Nodes[Point]] > 1)
+            {
+                IsJunction[Nodes[Point]] = true;
+                bHasJunction = true;
+            }
+        }
+
+        if (!bHasJunction)
+        {
+            IsJunction[Nodes[0]] = true;
+        }
+    }
+
+    TArray<int32> CandidateToNode;
+    CandidateToNode.Init(INDEX_NONE, CandidateLocations.Num());
+    NodeLocations.Reset();
+
+    for (int32 Candidate = 0; Candidate < CandidateLocations.Num(); ++Candidate)
+    {
+        if (IsJunction[Candidate])
+        {
+            CandidateToNode[Candidate] = NodeLocations.Add(CandidateLocations[Candidate]);
+        }
+    }
+
+    for (TArray<int32>& Nodes : OutPointNodes)
+    {
+        for (int32& Node : Nodes)
+        {
+            Node = CandidateToNode[Node];
+        }
+    }
+}
+
+// Split every spline at its junctions, each section becomes an edge
+void ASplineNetwork::BuildEdges(const TArray<TArray<int32>>& PointNodes)
+{
+    Edges.Reset();
+
+    for (int32 SplineIndex = 0; SplineIndex < Splines.Num(); ++SplineIndex)
+    {
+        const TArray<int32>& Nodes = PointNodes[SplineIndex];
+        if (Nodes.Num() == 0)
+        {
+            continue;
+        }
+
+        const USplineComponent* Spline = Splines[SplineIndex]->SplineComponent;
+        const int32 NumPoints = Nodes.Num();
+
+        TArray<int32> JunctionPoints;
+        for (int32 Point = 0; Point < NumPoints; ++Point)
+        {
+            if (Nodes[Point] != INDEX_NONE)
+            {
+                JunctionPoints.Add(Point);
+            }
+        }
+
+        // Closed loops also get the section from their last junction around to the first one
+        const int32 NumSections = Spline->IsClosedLoop() ? JunctionPoints.Num() : JunctionPoints.Num() - 1;
+        for (int32 Section = 0; Section < NumSections; ++Section)
+        {
+            const int32 StartPoint = JunctionPoints[Section];
+            const bool bWraps = Section + 1 == JunctionPoints.Num();
+            const int32 EndPoint = bWraps ? JunctionPoints[0] + NumPoints : JunctionPoints[Section + 1];
+
+            const float StartDistance = Spline->GetDistanceAlongSplineAtSplinePoint(StartPoint);
+            const float EndDistance = bWraps
+                ? Spline->GetSplineLength() + Spline->GetDistanceAlongSplineAtSplinePoint(JunctionPoints[0])
+                : Spline->GetDistanceAlongSplineAtSplinePoint(EndPoint);
+
+            const int32 FromNode = Nodes[StartPoint];
+            const int32 ToNode = Nodes[EndPoint % NumPoints];
+
+            AddEdge(SplineIndex, StartPoint, EndPoint, FromNode, ToNode, EndDistance - StartDistance);
+            if (bBidirectional)
+            {
+                AddEdge(SplineIndex, EndPoint, StartPoint, ToNode, FromNode, EndDistance - StartDistance);
+            }
+        }
+    }
+
+    // Compact adjacency, outgoing edges of a node are contiguous
+    Edges.StableSort([](const FSplineNetworkEdge& A, const FSplineNetworkEdge& B) { return A.FromNode < B.FromNode; });
+
+    NodeFirstEdges.Init(0, NodeLocations.Num() + 1);
+    for (const FSplineNetworkEdge& Edge : Edges)
+    {
+        ++NodeFirstEdges[Edge.FromNode + 1];
+    }
+    for (int32 Node = 0; Node < NodeLocations.Num(); ++Node)
+    {
+        NodeFirstEdges[Node + 1] += NodeFirstEdges[Node];
+    }
+}
+
+void ASplineNetwork::AddEdge(int32 SplineIndex, int32 StartPoint, int32 EndPoint, int32 FromNode, int32 ToNode, float Cost)
+{
+    // A loop with a single junction leads nowhere
+    if (FromNode == ToNode)
+    {
+        return;
+    }
+
+    FSplineNetworkEdge& Edge = Edges.AddDefaulted_GetRef();
+    Edge.FromNode = FromNode;
+    Edge.ToNode = ToNode;
+    Edge.SplineIndex = SplineIndex;
+    Edge.StartPoint = StartPoint;
+    Edge.EndPoint = EndPoint;
+    Edge.Cost = Cost;
+}
+
+FVector ASplineNetwork::GetNodeLocation(int32 Node) const
+{
+    return NodeLocations.IsValidIndex(Node) ? NodeLocations[Node] : FVector::ZeroVector;
+}
+
+int32 ASplineNetwork::FindNearestNode(const FVector& Location) const
+{
+    int32 NearestNode = INDEX_NONE;
+    double NearestDistanceSquared = TNumericLimits<double>::Max();
+
+    for (int32 Node = 0; Node < NodeLocations.Num(); ++Node)
+    {
+        const double DistanceSquared = FVector::DistSquared(NodeLocations[Node], Location);
+        if (DistanceSquared < NearestDistanceSquared)
+        {
+            NearestDistanceSquared = DistanceSquared;
+            NearestNode = Node;
+        }
+    }
+
+    return NearestNode;
+}
+
+// Dijkstra from FromNode to every node, memoised until the graph changes
+const FSplinePathTree& ASplineNetwork::FindOrBuildPathTree(int32 FromNode)
+{
+    if (const FSplinePathTree* CachedTree = PathTrees.Find(FromNode))
+    {
+        return *CachedTree;
+    }
+
+    if (PathTrees.Num() >= MaxCachedPathTrees)
+    {
+        PathTrees.Empty();
+    }
+
+    FSplinePathTree& Tree = PathTrees.Add(FromNode);
+    Tree.Costs.Init(TNumericLimits<float>::Max(), NodeLocations.Num());
+    Tree.PreviousEdges.Init(INDEX_NONE, NodeLocations.Num());
+    Tree.Costs[FromNode] = 0.0f;
+
+    typedef TPair<float, int32> FOpenNode;
+    const auto CheaperFirst = [](const FOpenNode& A, const FOpenNode& B) { return A.Key < B.Key; };
+
+    TArray<FOpenNode> Open;
+    Open.HeapPush(FOpenNode(0.0f, FromNode), CheaperFirst);
+
+    while (Open.Num() > 0)
+    {
+        FOpenNode Current;
+        Open.HeapPop(Current, CheaperFirst);
+
+        // Stale entry, the node was reached cheaper after it was queued
+        if (Current.Key > Tree.Costs[Current.Value])
+        {
+            continue;
+        }
+
+        for (int32 EdgeIndex = NodeFirstEdges[Current.Value]; EdgeIndex < NodeFirstEdges[Current.Value + 1]; ++EdgeIndex)
+        {
+            const FSplineNetworkEdge& Edge = Edges[EdgeIndex];
+            const float Cost = Current.Key + Edge.Cost;
+
+            if (Cost < Tree.Costs[Edge.ToNode])
+            {
+                Tree.Costs[Edge.ToNode] = Cost;
+                Tree.PreviousEdges[Edge.ToNode] = EdgeIndex;
+                Open.HeapPush(FOpenNode(Cost, Edge.ToNode), CheaperFirst);
+            }
+        }
+    }
+
+    return Tree;
+}
+
+void ASplineNetwork::RebuildGraphIfStale()
+{
+    if (IsGraphStale())
+    {
+        UE_LOG(LogTemp, Log, TEXT("%s: a member spline was destroyed or edited, rebuilding."), *GetName());
+        RebuildGraph();
+    }
+}
+
+bool ASplineNetwork::IsGraphStale() const
+{
+    for (int32 i = 0; i < BuiltSplines.Num(); ++i)
+    {
+        const USplineComponent* Spline = BuiltSplines[i].Get();
+        if (!IsValid(Spline) || Spline->SplineCurves.Version != BuiltSplineVersions[i])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ASplineNetwork::FindPath(int32 FromNode, int32 ToNode, TArray<int32>& OutEdges)
+{
+    OutEdges.Reset();
+    RebuildGraphIfStale();
+
+    if (!NodeLocations.IsValidIndex(FromNode) || !NodeLocations.IsValidIndex(ToNode))
+    {
+        return false;
+    }
+
+    const FSplinePathTree& Tree = FindOrBuildPathTree(FromNode);
+    if (Tree.Costs[ToNode] == TNumericLimits<float>::Max())
+    {
+        return false;
+    }
+
+    for (int32 Node = ToNode; Node != FromNode; Node = Edges[Tree.PreviousEdges[Node]].FromNode)
+    {
+        OutEdges.Add(Tree.PreviousEdges[Node]);
+    }
+
+    Algo::Reverse(OutEdges);
+    return true;
+}
+
+float ASplineNetwork::GetPathCost(int32 FromNode, int32 ToNode)
+{
+    RebuildGraphIfStale();
+
+    if (!NodeLocations.IsValidIndex(FromNode) || !NodeLocations.IsValidIndex(ToNode))
+    {
+        return -1.0f;
+    }
+
+    const float Cost = FindOrBuildPathTree(FromNode).Costs[ToNode];
+    return Cost == TNumericLimits<float>::Max() ? -1.0f : Cost;
+}
+
+USplineComponent* ASplineNetwork::GetRouteSpline(int32 FromNode, int32 ToNode)
+{
+    // A rebuild destroys the cached route splines, so check before looking them up
+    RebuildGraphIfStale();
+
+    const int64 RouteKey = (static_cast<int64>(FromNode) << 32) | static_cast<uint32>(ToNode);
+    if (USplineComponent* const* CachedRoute = RouteSplines.Find(RouteKey))
+    {
+        if (IsValid(*CachedRoute))
+        {
+            return *CachedRoute;
+        }
+    }
+
+    TArray<int32> PathEdges;
+    if (!FindPath(FromNode, ToNode, PathEdges) || PathEdges.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    USplineComponent* Route = CreateRouteSpline(PathEdges);
+    if (Route)
+    {
+        RouteSplines.Add(RouteKey, Route);
+    }
+    return Route;
+}
+
+// Copy the spline points along the path into one world space spline, junctions are shared by consecutive edges
+USplineComponent* ASplineNetwork::CreateRouteSpline(const TArray<int32>& PathEdges)
+{
+    for (int32 EdgeIndex : PathEdges)
+    {
+        const ASplineTrackerActor* SplineActor = Splines.IsValidIndex(Edges[EdgeIndex].SplineIndex) ? Splines[Edges[EdgeIndex].SplineIndex] : nullptr;
+        if (!IsValid(SplineActor) || !IsValid(SplineActor->SplineComponent))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("%s: a spline on the route is gone, call RebuildGraph after changing Splines."), *GetName());
+            return nullptr;
+        }
+    }
+
+    USplineComponent* Route = NewObject<USplineComponent>(this, NAME_None, RF_Transient);
+    Route->SetupAttachment(GetRootComponent());
+    Route->SetHiddenInGame(true);
+    Route->RegisterComponent();
+    Route->ClearSplinePoints(false);
+
+    int32 NumRoutePoints = 0;
+    FVector LastArriveTangent = FVector::ZeroVector;
+
+    for (int32 EdgeIndex : PathEdges)
+    {
+        const FSplineNetworkEdge& Edge = Edges[EdgeIndex];
+        const USplineComponent* Spline = Splines[Edge.SplineIndex]->SplineComponent;
+        const int32 NumPoints = Spline->GetNumberOfSplinePoints();
+        const int32 Step = Edge.EndPoint >= Edge.StartPoint ? 1 : -1;
+
+        for (int32 Point = Edge.StartPoint; ; Point += Step)
+        {
+            const int32 SplinePoint = Point % NumPoints;
+
+            // Travelling against the spline swaps and flips the tangents
+            FVector ArriveTangent = Spline->GetArriveTangentAtSplinePoint(SplinePoint, ESplineCoordinateSpace::World);
+            FVector LeaveTangent = Spline->GetLeaveTangentAtSplinePoint(SplinePoint, ESplineCoordinateSpace::World);
+            if (Step < 0)
+            {
+                Swap(ArriveTangent, LeaveTangent);
+                ArriveTangent = -ArriveTangent;
+                LeaveTangent = -LeaveTangent;
+            }
+
+            if (Point == Edge.StartPoint && NumRoutePoints > 0)
+            {
+                // The junction was added by the previous edge, it leaves along this one
+                Route->SetTangentsAtSplinePoint(NumRoutePoints - 1, LastArriveTangent, LeaveTangent, ESplineCoordinateSpace::World, false);
+            }
+            else
+            {
+                Route->AddSplinePoint(Spline->GetLocationAtSplinePoint(SplinePoint, ESplineCoordinateSpace::World), ESplineCoordinateSpace::World, false);
+                Route->SetTangentsAtSplinePoint(NumRoutePoints, ArriveTangent, LeaveTangent, ESplineCoordinateSpace::World, false);
+
+                const ESplinePointType::Type PointType = Spline->GetSplinePointType(SplinePoint);
+                if (PointType == ESplinePointType::Linear || PointType == ESplinePointType::Constant)
+                {
+                    Route->SetSplinePointType(NumRoutePoints, PointType, false);
+                }
+
+                LastArriveTangent = ArriveTangent;
+                ++NumRoutePoints;
+            }
+
+            if (Point == Edge.EndPoint)
+            {
+                break;
+            }
+        }
+    }
+
+    Route->UpdateSpline();
+    return Route;
+}
+
+void ASplineNetwork::ClearRouteSplines()
+{
+    for (const TPair<int64, USplineComponent*>& RouteSpline : RouteSplines)
+    {
+        if (IsValid(RouteSpline.Value))
+        {
+            RouteSpline.Value->DestroyComponent();
+        }
+    }
+
+    RouteSplines.Empty();
+}
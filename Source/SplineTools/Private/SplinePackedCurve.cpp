@@ -0,0 +1,203 @@
+#include "SplinePackedCurve.h"
+#include "Components/SplineComponent.h"
+#include "Math/VectorRegister.h"
+
+void FSplinePackedCurve::Build(const USplineComponent& Spline)
+{
+    const FInterpCurveVector& Position = Spline.SplineCurves.Position;
+    const TArray<FInterpCurvePoint<FVector>>& Points = Position.Points;
+
+    SplineLength = Spline.GetSplineLength();
+    SourceSpline = &Spline;
+    SplineVersion = Spline.SplineCurves.Version;
+    NumSplinePoints = Spline.GetNumberOfSplinePoints();
+    bClosedLoop = Spline.IsClosedLoop();
+
+    NumSegments = Points.Num() < 2 ? 0 : (Position.bIsLooped ? Points.Num() : Points.Num() - 1);
+
+    for (TArray<float>* Coefficients : { &AX, &AY, &AZ, &BX, &BY, &BZ, &CX, &CY, &CZ, &DX, &DY, &DZ, &InvKeyRanges })
+    {
+        Coefficients->SetNumUninitialized(NumSegments);
+    }
+
+    for (int32 i = 0; i < NumSegments; ++i)
+    {
+        const FInterpCurvePoint<FVector>& Start = Points[i];
+        const bool bLoopSegment = i == Points.Num() - 1;
+        const FInterpCurvePoint<FVector>& End = bLoopSegment ? Points[0] : Points[i + 1];
+        const float KeyRange = bLoopSegment ? Position.LoopKeyOffset : End.InVal - Start.InVal;
+
+        // Same cases as FInterpCurve::Eval, written as one cubic
+        FVector A = FVector::ZeroVector;
+        FVector B = FVector::ZeroVector;
+        FVector C = FVector::ZeroVector;
+        const FVector D = Start.OutVal;
+
+        if (Start.InterpMode == CIM_Linear)
+        {
+            C = End.OutVal - Start.OutVal;
+        }
+        else if (Start.InterpMode != CIM_Constant)
+        {
+            const FVector T0 = Start.LeaveTangent * KeyRange;
+            const FVector T1 = End.ArriveTangent * KeyRange;
+            A = 2.0f * Start.OutVal + T0 - 2.0f * End.OutVal + T1;
+            B = -3.0f * Start.OutVal - 2.0f * T0 + 3.0f * End.OutVal - T1;
+            C = T0;
+        }
+
+        AX[i] = A.X; AY[i] = A.Y; AZ[i] = A.Z;
+        BX[i] = B.X; BY[i] = B.Y; BZ[i] = B.Z;
+        CX[i] = C.X; CY[i] = C.Y; CZ[i] = C.Z;
+        DX[i] = D.X; DY[i] = D.Y; DZ[i] = D.Z;
+        InvKeyRanges[i] = KeyRange > KINDA_SMALL_NUMBER ? 1.0f / KeyRange : 0.0f;
+    }
+
+    // Re-express the reparam table's input keys as segment parameters, which stay linear between entries
+    const TArray<FInterpCurvePoint<float>>& ReparamPoints = Spline.SplineCurves.ReparamTable.Points;
+    ReparamDistances.SetNumUninitialized(ReparamPoints.Num());
+    ReparamParameters.SetNumUninitialized(ReparamPoints.Num());
+
+    for (int32 i = 0; i < ReparamPoints.Num(); ++i)
+    {
+        const float Key = ReparamPoints[i].OutVal;
+        const int32 Segment = FMath::Clamp(Position.GetPointIndexForInputValue(Key), 0, FMath::Max(NumSegments - 1, 0));
+        const float SegmentAlpha = NumSegments > 0 ? (Key - Points[Segment].InVal) * InvKeyRanges[Segment] : 0.0f;
+
+        ReparamDistances[i] = ReparamPoints[i].InVal;
+        ReparamParameters[i] = Segment + FMath::Clamp(SegmentAlpha, 0.0f, 1.0f);
+    }
+}
+
+bool FSplinePackedCurve::IsUpToDate(const USplineComponent& Spline) const
+{
+    return IsValid()
+        && SourceSpline == TObjectKey<USplineComponent>(&Spline)
+        && SplineVersion == Spline.SplineCurves.Version
+        && NumSplinePoints == Spline.GetNumberOfSplinePoints()
+        && bClosedLoop == Spline.IsClosedLoop();
+}
+
+float FSplinePackedCurve::GetSegmentParameter(float Distance) const
+{
+    // Last entry whose distance is not past the requested one
+    int32 Low = 0;
+    int32 High = ReparamDistances.Num() - 2;
+    while (Low < High)
+    {
+        const int32 Middle = (Low + High + 1) / 2;
+        if (ReparamDistances[Middle] <= Distance)
+        {
+            Low = Middle;
+        }
+        else
+        {
+            High = Middle - 1;
+        }
+    }
+
+    const float Range = ReparamDistances[Low + 1] - ReparamDistances[Low];
+    const float Alpha = Range > KINDA_SMALL_NUMBER ? FMath::Clamp((Distance - ReparamDistances[Low]) / Range, 0.0f, 1.0f) : 0.0f;
+
+    return FMath::Lerp(ReparamParameters[Low], ReparamParameters[Low + 1], Alpha);
+}
+
+void FSplinePackedCurve::Evaluate(float Distance, FVector& OutLocation, FVector& OutTangent) const
+{
+    if (!IsValid())
+    {
+        OutLocation = FVector::ZeroVector;
+        OutTangent = FVector::ZeroVector;
+        return;
+    }
+
+    const float Parameter = GetSegmentParameter(FMath::Clamp(Distance, 0.0f, SplineLength));
+    const int32 i = FMath::Min(FMath::FloorToInt(Parameter), NumSegments - 1);
+    const float T = Parameter - i;
+
+    OutLocation.X = ((AX[i] * T + BX[i]) * T + CX[i]) * T + DX[i];
+    OutLocation.Y = ((AY[i] * T + BY[i]) * T + CY[i]) * T + DY[i];
+    OutLocation.Z = ((AZ[i] * T + BZ[i]) * T + CZ[i]) * T + DZ[i];
+
+    OutTangent.X = ((3.0f * AX[i] * T + 2.0f * BX[i]) * T + CX[i]) * InvKeyRanges[i];
+    OutTangent.Y = ((3.0f * AY[i] * T + 2.0f * BY[i]) * T + CY[i]) * InvKeyRanges[i];
+    OutTangent.Z = ((3.0f * AZ[i] * T + 2.0f * BZ[i]) * T + CZ[i]) * InvKeyRanges[i];
+}
+
+void FSplinePackedCurve::EvaluateBatch(TArrayView<const float> Distances, TArrayView<FVector> OutLocations, TArrayView<FVector> OutTangents) const
+{
+    check(OutLocations.Num() >= Distances.Num() && OutTangents.Num() >= Distances.Num());
+
+    if (!IsValid())
+    {
+        return;
+    }
+
+    int32 Index = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+    for (; Index + LaneCount <= Distances.Num(); Index += LaneCount)
+    {
+        EvaluateLanes(&Distances[Index], &OutLocations[Index], &OutTangents[Index]);
+    }
+#endif
+
+    // Remaining distances, or all of them without vector intrinsics
+    for (; Index < Distances.Num(); ++Index)
+    {
+        Evaluate(Distances[Index], OutLocations[Index], OutTangents[Index]);
+    }
+}
+
+void FSplinePackedCurve::EvaluateLanes(const float* Distances, FVector* OutLocations, FVector* OutTangents) const
+{
+    alignas(16) float T[LaneCount];
+    alignas(16) float Gathered[13][LaneCount];
+
+    // The reparam search is scalar, the segment coefficients are then gathered into one register per term
+    for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+    {
+        const float Parameter = GetSegmentParameter(FMath::Clamp(Distances[Lane], 0.0f, SplineLength));
+        const int32 i = FMath::Min(FMath::FloorToInt(Parameter), NumSegments - 1);
+        T[Lane] = Parameter - i;
+
+        Gathered[0][Lane] = AX[i]; Gathered[1][Lane] = AY[i]; Gathered[2][Lane] = AZ[i];
+        Gathered[3][Lane] = BX[i]; Gathered[4][Lane] = BY[i]; Gathered[5][Lane] = BZ[i];
+        Gathered[6][Lane] = CX[i]; Gathered[7][Lane] = CY[i]; Gathered[8][Lane] = CZ[i];
+        Gathered[9][Lane] = DX[i]; Gathered[10][Lane] = DY[i]; Gathered[11][Lane] = DZ[i];
+        Gathered[12][Lane] = InvKeyRanges[i];
+    }
+
+    const VectorRegister4Float VecT = VectorLoadAligned(T);
+    const VectorRegister4Float VecInvKeyRange = VectorLoadAligned(Gathered[12]);
+    const VectorRegister4Float Three = VectorSetFloat1(3.0f);
+    const VectorRegister4Float Two = VectorSetFloat1(2.0f);
+
+    alignas(16) float Locations[3][LaneCount];
+    alignas(16) float Tangents[3][LaneCount];
+
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        const VectorRegister4Float A = VectorLoadAligned(Gathered[Axis]);
+        const VectorRegister4Float B = VectorLoadAligned(Gathered[3 + Axis]);
+        const VectorRegister4Float C = VectorLoadAligned(Gathered[6 + Axis]);
+        const VectorRegister4Float D = VectorLoadAligned(Gathered[9 + Axis]);
+
+        VectorRegister4Float Location = VectorMultiplyAdd(A, VecT, B);
+        Location = VectorMultiplyAdd(Location, VecT, C);
+        Location = VectorMultiplyAdd(Location, VecT, D);
+
+        VectorRegister4Float Tangent = VectorMultiplyAdd(VectorMultiply(Three, A), VecT, VectorMultiply(Two, B));
+        Tangent = VectorMultiplyAdd(Tangent, VecT, C);
+        Tangent = VectorMultiply(Tangent, VecInvKeyRange);
+
+        VectorStoreAligned(Location, Locations[Axis]);
+        VectorStoreAligned(Tangent, Tangents[Axis]);
+    }
+
+    for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+    {
+        OutLocations[Lane] = FVector(Locations[0][Lane], Locations[1][Lane], Locations[2][Lane]);
+        OutTangents[Lane] = FVector(Tangents[0][Lane], Tangents[1][Lane], Tangents[2][Lane]);
+    }
+}
@@ -0,0 +1,148 @@
+#include "SplinePoseSharingSubsystem.h"
+#include "SplineCurveCopy.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/SplineComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "Stats/Stats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Evaluated Spline Follower Poses"), STAT_SplineFollowerEvaluatedPoses, STATGROUP_Game);
+
+bool USplinePoseSharingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USplinePoseSharingSubsystem::Deinitialize()
+{
+    Groups.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId USplinePoseSharingSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USplinePoseSharingSubsystem, STATGROUP_Tickables);
+}
+
+void USplinePoseSharingSubsystem::Tick(float DeltaTime)
+{
+    // World subsystems tick after the frame's animation work, so this closes the frame's count
+    EvaluatedPosesLastFrame = EvaluatedPosesThisFrame;
+    EvaluatedPosesThisFrame = 0;
+
+    SET_DWORD_STAT(STAT_SplineFollowerEvaluatedPoses, EvaluatedPosesLastFrame);
+}
+
+FSplinePoseGroupKey USplinePoseSharingSubsystem::MakeGroupKey(const USplineComponent* Spline, const USkeletalMeshComponent* MeshComponent)
+{
+    FSplinePoseGroupKey Key;
+
+    // A hash collision only lets followers with the same mesh and animation share a pose across paths
+    const FTransform& SplineTransform = Spline->GetComponentTransform();
+    Key.PathHash = FSplineCurveCopy::HashCurves(Spline->SplineCurves);
+    Key.PathHash = HashCombine(Key.PathHash, GetTypeHash(SplineTransform.GetLocation()));
+    Key.PathHash = HashCombine(Key.PathHash, GetTypeHash(SplineTransform.GetRotation()));
+    Key.PathHash = HashCombine(Key.PathHash, GetTypeHash(SplineTransform.GetScale3D()));
+    Key.Mesh = MeshComponent->GetSkeletalMeshAsset();
+
+    if (MeshComponent->GetAnimationMode() == EAnimationMode::AnimationBlueprint)
+    {
+        Key.Animation = MeshComponent->GetAnimClass();
+    }
+    else
+    {
+        Key.Animation = MeshComponent->AnimationData.AnimToPlay;
+    }
+
+    return Key;
+}
+
+void USplinePoseSharingSubsystem::RegisterFollower(USkeletalMeshComponent* MeshComponent, const FSplinePoseGroupKey& Key, int32 FollowersPerLeader)
+{
+    if (!MeshComponent)
+    {
+        return;
+    }
+
+    FPoseGroup& Group = Groups.FindOrAdd(Key);
+    if (Group.Members.Num() == 0)
+    {
+        Group.ChunkSize = FMath::Max(FollowersPerLeader, 0) + 1;
+    }
+
+    const int32 MemberIndex = Group.Members.AddUnique(MeshComponent);
+    AssignLeaders(Group, MemberIndex);
+}
+
+void USplinePoseSharingSubsystem::UnregisterFollower(USkeletalMeshComponent* MeshComponent, const FSplinePoseGroupKey& Key)
+{
+    FPoseGroup* Group = Groups.Find(Key);
+    if (!Group)
+    {
+        return;
+    }
+
+    const int32 MemberIndex = Group->Members.IndexOfByKey(MeshComponent);
+    if (MemberIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (MeshComponent)
+    {
+        MeshComponent->SetLeaderPoseComponent(nullptr);
+    }
+
+    // Keep the order so only members after the removed one change leaders
+    Group->Members.RemoveAt(MemberIndex);
+
+    if (Group->Members.Num() == 0)
+    {
+        Groups.Remove(Key);
+    }
+    else
+    {
+        AssignLeaders(*Group, MemberIndex);
+    }
+}
+
+void USplinePoseSharingSubsystem::AssignLeaders(FPoseGroup& Group, int32 FirstMember)
+{
+    for (int32 i = FirstMember; i < Group.Members.Num(); ++i)
+    {
+        USkeletalMeshComponent* Member = Group.Members[i].Get();
+        if (!Member)
+        {
+            continue;
+        }
+
+        const int32 LeaderIndex = (i / Group.ChunkSize) * Group.ChunkSize;
+        USkeletalMeshComponent* Leader = LeaderIndex != i ? Group.Members[LeaderIndex].Get() : nullptr;
+
+        if (Member->LeaderPoseComponent.Get() != Leader)
+        {
+            Member->SetLeaderPoseComponent(Leader);
+        }
+    }
+}
+
+void USplinePoseSharingSubsystem::TrackPoseEvaluations(USkeletalMeshComponent* MeshComponent)
+{
+    if (MeshComponent)
+    {
+        MeshComponent->OnBoneTransformsFinalizedMC.AddUObject(this, &USplinePoseSharingSubsystem::OnPoseEvaluated);
+    }
+}
+
+void USplinePoseSharingSubsystem::UntrackPoseEvaluations(USkeletalMeshComponent* MeshComponent)
+{
+    if (MeshComponent)
+    {
+        MeshComponent->OnBoneTransformsFinalizedMC.RemoveAll(this);
+    }
+}
+
+void USplinePoseSharingSubsystem::OnPoseEvaluated()
+{
+    ++EvaluatedPosesThisFrame;
+}
@@ -0,0 +1,280 @@
+#include "SplineSpatialIndex.h"
+#include "SplineDistanceTable.h"
+#include "Components/SplineComponent.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Sort.h"
+
+// Below this many queries a batch runs on the calling thread only
+static constexpr int32 ParallelQueryThreshold = 64;
+
+void FSplineBoundingVolumeHierarchy::Build(TConstArrayView<FBox> ItemBounds)
+{
+    Nodes.Reset();
+    Items.Reset();
+
+    if (ItemBounds.Num() == 0)
+    {
+        return;
+    }
+
+    Items.SetNumUninitialized(ItemBounds.Num());
+    for (int32 i = 0; i < Items.Num(); ++i)
+    {
+        Items[i] = i;
+    }
+
+    Nodes.Reserve(2 * ItemBounds.Num() / MaxLeafItems + 1);
+    Nodes.AddDefaulted();
+    BuildNode(0, 0, Items.Num(), ItemBounds);
+}
+
+// Split at the median of the item centers along the longest axis
+void FSplineBoundingVolumeHierarchy::BuildNode(int32 NodeIndex, int32 Begin, int32 End, TConstArrayView<FBox> ItemBounds)
+{
+    FBox Bounds(ForceInit);
+    FBox CenterBounds(ForceInit);
+    for (int32 i = Begin; i < End; ++i)
+    {
+        Bounds += ItemBounds[Items[i]];
+        CenterBounds += ItemBounds[Items[i]].GetCenter();
+    }
+
+    Nodes[NodeIndex].Bounds = Bounds;
+
+    if (End - Begin <= MaxLeafItems)
+    {
+        Nodes[NodeIndex].First = Begin;
+        Nodes[NodeIndex].NumItems = End - Begin;
+        return;
+    }
+
+    const FVector Extent = CenterBounds.GetExtent();
+    const int32 Axis = Extent.X >= Extent.Y && Extent.X >= Extent.Z ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+
+    TArrayView<int32> Range(Items.GetData() + Begin, End - Begin);
+    Algo::Sort(Range, [&ItemBounds, Axis](int32 A, int32 B) { return ItemBounds[A].GetCenter()[Axis] < ItemBounds[B].GetCenter()[Axis]; });
+
+    // Children are stored next to each other, after their parent
+    const int32 FirstChild = Nodes.AddDefaulted(2);
+    Nodes[NodeIndex].First = FirstChild;
+    Nodes[NodeIndex].NumItems = 0;
+
+    const int32 Middle = Begin + (End - Begin) / 2;
+    BuildNode(FirstChild, Begin, Middle, ItemBounds);
+    BuildNode(FirstChild + 1, Middle, End, ItemBounds);
+}
+
+void FSplineBoundingVolumeHierarchy::Refit(TConstArrayView<FBox> ItemBounds)
+{
+    // Children always come after their parent, so walking backwards visits them first
+    for (int32 NodeIndex = Nodes.Num() - 1; NodeIndex >= 0; --NodeIndex)
+    {
+        FNode& Node = Nodes[NodeIndex];
+        if (Node.NumItems > 0)
+        {
+            Node.Bounds = FBox(ForceInit);
+            for (int32 i = Node.First; i < Node.First + Node.NumItems; ++i)
+            {
+                Node.Bounds += ItemBounds[Items[i]];
+            }
+        }
+        else
+        {
+            Node.Bounds = Nodes[Node.First].Bounds + Nodes[Node.First + 1].Bounds;
+        }
+    }
+}
+
+void FSplineSpatialIndex::AddSpline(USplineComponent* Spline)
+{
+    if (!Spline || SplineIndices.Contains(Spline))
+    {
+        return;
+    }
+
+    const int32 Index = Splines.AddDefaulted();
+    Splines[Index].Key = Spline;
+    SplineIndices.Add(Spline, Index);
+    BakeSpline(Splines[Index], *Spline);
+
+    bTopLevelNeedsBuild = true;
+}
+
+void FSplineSpatialIndex::RemoveSpline(const USplineComponent* Spline)
+{
+    int32 Index = INDEX_NONE;
+    if (!SplineIndices.RemoveAndCopyValue(Spline, Index))
+    {
+        return;
+    }
+
+    Splines.RemoveAtSwap(Index);
+    if (Index < Splines.Num())
+    {
+        SplineIndices.Add(Splines[Index].Key, Index);
+    }
+
+    bTopLevelNeedsBuild = true;
+}
+
+void FSplineSpatialIndex::UpdateSpline(USplineComponent* Spline)
+{
+    const int32* Index = Spline ? SplineIndices.Find(Spline) : nullptr;
+    if (!Index)
+    {
+        return;
+    }
+
+    BakeSpline(Splines[*Index], *Spline);
+    bTopLevelNeedsRefit = true;
+}
+
+int32 FSplineSpatialIndex::UpdateChangedSplines()
+{
+    int32 NumUpdated = 0;
+
+    for (FIndexedSpline& Indexed : Splines)
+    {
+        USplineComponent* Spline = Indexed.Spline.Get();
+        if (Spline && (Indexed.SplineVersion != Spline->SplineCurves.Version || !Indexed.ComponentToWorld.Equals(Spline->GetComponentTransform())))
+        {
+            BakeSpline(Indexed, *Spline);
+            ++NumUpdated;
+        }
+    }
+
+    bTopLevelNeedsRefit |= NumUpdated > 0;
+    return NumUpdated;
+}
+
+void FSplineSpatialIndex::Prepare()
+{
+    if (!bTopLevelNeedsBuild && !bTopLevelNeedsRefit)
+    {
+        return;
+    }
+
+    TArray<FBox> SplineBounds;
+    SplineBounds.Reserve(Splines.Num());
+    for (const FIndexedSpline& Indexed : Splines)
+    {
+        SplineBounds.Add(Indexed.Segments.GetBounds());
+    }
+
+    // A single edited spline only changes boxes, the tree shape can stay
+    if (bTopLevelNeedsBuild)
+    {
+        TopLevel.Build(SplineBounds);
+    }
+    else
+    {
+        TopLevel.Refit(SplineBounds);
+    }
+
+    bTopLevelNeedsBuild = false;
+    bTopLevelNeedsRefit = false;
+}
+
+// Linearize the spline within MaxError and build the hierarchy over its segments
+void FSplineSpatialIndex::BakeSpline(FIndexedSpline& Indexed, USplineComponent& Spline) const
+{
+    FSplineDistanceTable Table;
+    Table.Build(Spline, SampleSpacing, MaxError);
+
+    Indexed.Spline = &Spline;
+    Indexed.SplineVersion = Spline.SplineCurves.Version;
+    Indexed.ComponentToWorld = Spline.GetComponentTransform();
+    Indexed.PointSpacing = Table.GetSampleSpacing();
+
+    Indexed.Points.Reset(Table.GetLocations().Num());
+    for (const FVector& Location : Table.GetLocations())
+    {
+        Indexed.Points.Add(Indexed.ComponentToWorld.TransformPosition(Location));
+    }
+
+    TArray<FBox> SegmentBounds;
+    SegmentBounds.Reserve(FMath::Max(Indexed.Points.Num() - 1, 0));
+    for (int32 i = 0; i + 1 < Indexed.Points.Num(); ++i)
+    {
+        SegmentBounds.Add(FBox(ForceInit) + Indexed.Points[i] + Indexed.Points[i + 1]);
+    }
+
+    Indexed.Segments.Build(SegmentBounds);
+}
+
+void FSplineSpatialIndex::FindNearestOnSpline(const FIndexedSpline& Indexed, const FVector& Location, double& InOutBestDistanceSquared, FSplineSpatialHit& OutHit) const
+{
+    USplineComponent* Spline = Indexed.Spline.Get();
+    if (!Spline)
+    {
+        return;
+    }
+
+    Indexed.Segments.FindNearest(Location, InOutBestDistanceSquared, [&](int32 Segment, double& BestDistanceSquared)
+    {
+        const FVector& Start = Indexed.Points[Segment];
+        const FVector& End = Indexed.Points[Segment + 1];
+        const FVector Closest = FMath::ClosestPointOnSegment(Location, Start, End);
+        const double DistanceSquared = FVector::DistSquared(Closest, Location);
+
+        if (DistanceSquared < BestDistanceSquared)
+        {
+            BestDistanceSquared = DistanceSquared;
+
+            const double SegmentLength = FVector::Dist(Start, End);
+            const double Alpha = SegmentLength > KINDA_SMALL_NUMBER ? FVector::Dist(Start, Closest) / SegmentLength : 0.0;
+
+            OutHit.Spline = Spline;
+            OutHit.SplineDistance = static_cast<float>((Segment + Alpha) * Indexed.PointSpacing);
+            OutHit.Location = Closest;
+            OutHit.DistanceSquared = DistanceSquared;
+        }
+    });
+}
+
+bool FSplineSpatialIndex::FindNearest(const FVector& Location, double MaxDistance, FSplineSpatialHit& OutHit) const
+{
+    checkf(!bTopLevelNeedsBuild && !bTopLevelNeedsRefit, TEXT("Call Prepare after changing the spline spatial index"));
+
+    OutHit = FSplineSpatialHit();
+    double BestDistanceSquared = FMath::Square(MaxDistance);
+
+    TopLevel.FindNearest(Location, BestDistanceSquared, [&](int32 SplineIndex, double& InOutBestDistanceSquared)
+    {
+        FindNearestOnSpline(Splines[SplineIndex], Location, InOutBestDistanceSquared, OutHit);
+    });
+
+    return OutHit.IsValid();
+}
+
+void FSplineSpatialIndex::FindInRadius(const FVector& Location, double Radius, TArray<FSplineSpatialHit>& OutHits) const
+{
+    checkf(!bTopLevelNeedsBuild && !bTopLevelNeedsRefit, TEXT("Call Prepare after changing the spline spatial index"));
+
+    OutHits.Reset();
+
+    TopLevel.ForEachInRadius(Location, Radius, [&](int32 SplineIndex)
+    {
+        FSplineSpatialHit Hit;
+        double BestDistanceSquared = FMath::Square(Radius);
+        FindNearestOnSpline(Splines[SplineIndex], Location, BestDistanceSquared, Hit);
+
+        if (Hit.IsValid())
+        {
+            OutHits.Add(Hit);
+        }
+    });
+
+    OutHits.Sort([](const FSplineSpatialHit& A, const FSplineSpatialHit& B) { return A.DistanceSquared < B.DistanceSquared; });
+}
+
+void FSplineSpatialIndex::FindNearestBatch(TConstArrayView<FVector> Locations, double MaxDistance, TArrayView<FSplineSpatialHit> OutHits) const
+{
+    check(OutHits.Num() >= Locations.Num());
+
+    // Queries only read the index, each one writes its own hit
+    ParallelFor(Locations.Num(), [this, Locations, MaxDistance, OutHits](int32 i) mutable
+    {
+        FindNearest(Locations[i], MaxDistance, OutHits[i]);
+    }, Locations.Num() < ParallelQueryThreshold);
+}
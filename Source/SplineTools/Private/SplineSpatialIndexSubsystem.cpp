@@ -0,0 +1,94 @@
+#include "SplineSpatialIndexSubsystem.h"
+#include "Components/SplineComponent.h"
+
+bool USplineSpatialIndexSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USplineSpatialIndexSubsystem::Deinitialize()
+{
+    Index = FSplineSpatialIndex();
+
+    Super::Deinitialize();
+}
+
+void USplineSpatialIndexSubsystem::AddSpline(USplineComponent* Spline)
+{
+    Index.AddSpline(Spline);
+}
+
+void USplineSpatialIndexSubsystem::RemoveSpline(USplineComponent* Spline)
+{
+    Index.RemoveSpline(Spline);
+}
+
+void USplineSpatialIndexSubsystem::UpdateSpline(USplineComponent* Spline)
+{
+    Index.UpdateSpline(Spline);
+}
+
+int32 USplineSpatialIndexSubsystem::UpdateChangedSplines()
+{
+    return Index.UpdateChangedSplines();
+}
+
+const FSplineSpatialIndex& USplineSpatialIndexSubsystem::GetIndex()
+{
+    Index.Prepare();
+    return Index;
+}
+
+bool USplineSpatialIndexSubsystem::FindNearestSpline(const FVector& Location, float MaxDistance, FSplineQueryResult& OutResult)
+{
+    FSplineSpatialHit Hit;
+    const bool bFound = GetIndex().FindNearest(Location, MaxDistance, Hit);
+
+    OutResult = ToQueryResult(Hit);
+    return bFound;
+}
+
+TArray<FSplineQueryResult> USplineSpatialIndexSubsystem::FindSplinesInRadius(const FVector& Location, float Radius)
+{
+    TArray<FSplineSpatialHit> Hits;
+    GetIndex().FindInRadius(Location, Radius, Hits);
+
+    TArray<FSplineQueryResult> Results;
+    Results.Reserve(Hits.Num());
+    for (const FSplineSpatialHit& Hit : Hits)
+    {
+        Results.Add(ToQueryResult(Hit));
+    }
+
+    return Results;
+}
+
+TArray<FSplineQueryResult> USplineSpatialIndexSubsystem::FindNearestSplines(const TArray<FVector>& Locations, float MaxDistance)
+{
+    TArray<FSplineSpatialHit> Hits;
+    Hits.SetNum(Locations.Num());
+    GetIndex().FindNearestBatch(Locations, MaxDistance, Hits);
+
+    TArray<FSplineQueryResult> Results;
+    Results.Reserve(Hits.Num());
+    for (const FSplineSpatialHit& Hit : Hits)
+    {
+        Results.Add(ToQueryResult(Hit));
+    }
+
+    return Results;
+}
+
+FSplineQueryResult USplineSpatialIndexSubsystem::ToQueryResult(const FSplineSpatialHit& Hit)
+{
+    FSplineQueryResult Result;
+    if (Hit.IsValid())
+    {
+        Result.Spline = Hit.Spline;
+        Result.SplineDistance = Hit.SplineDistance;
+        Result.Location = Hit.Location;
+        Result.Distance = FMath::Sqrt(Hit.DistanceSquared);
+    }
+
+    return Result;
+}
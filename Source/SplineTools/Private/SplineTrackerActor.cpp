@@ -4,6 +4,7 @@
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
 #include "UObject/ConstructorHelpers.h"
+#include "SplineSpatialIndexSubsystem.h"
 #if WITH_EDITOR
 #include "SplineManagerTool.h"
 #endif
@@ -29,6 +30,27 @@ ASplineTrackerActor::ASplineTrackerActor()
 void ASplineTrackerActor::BeginPlay()
 {
     Super::BeginPlay();
+
+    if (bAddToSpatialIndex)
+    {
+        if (USplineSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<USplineSpatialIndexSubsystem>())
+        {
+            SpatialIndex->AddSpline(SplineComponent);
+        }
+    }
+}
+
+void ASplineTrackerActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (bAddToSpatialIndex)
+    {
+        if (USplineSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<USplineSpatialIndexSubsystem>())
+        {
+            SpatialIndex->RemoveSpline(SplineComponent);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void ASplineTrackerActor::OnConstruction(const FTransform& Transform)
@@ -2,6 +2,8 @@
 #include "Components/SplineComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "SplineFollowerSubsystem.h"
 
 AStaticSplineFollower::AStaticSplineFollower()
 {
@@ -35,7 +37,124 @@ void AStaticSplineFollower::OnConstruction(const FTransform& Transform)
 // BeginPlay
 void AStaticSplineFollower::BeginPlay()
 {
+    // Instanced followers are moved by the instance manager instead of the follower subsystem
+    if (bUseInstancedRendering)
+    {
+        bUseBatchedUpdate = false;
+    }
+
     Super::BeginPlay();
 
     ActiveMesh = Cast<UMeshComponent>(StaticMeshComponent);
+
+    if (bUseInstancedRendering)
+    {
+        HandOffToInstanceManager(true);
+    }
+}
+
+// EndPlay
+void AStaticSplineFollower::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    RemoveInstance();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+// The instance would keep rendering and moving while the actor is parked
+void AStaticSplineFollower::OnReleasedToPool()
+{
+    RemoveInstance();
+
+    Super::OnReleasedToPool();
+}
+
+void AStaticSplineFollower::OnAcquiredFromPool()
+{
+    Super::OnAcquiredFromPool();
+
+    if (bUseInstancedRendering)
+    {
+        HandOffToInstanceManager(false);
+    }
+}
+
+void AStaticSplineFollower::RemoveInstance()
+{
+    if (!InstanceHandle.IsValid())
+    {
+        return;
+    }
+
+    if (ASplineInstancedFollowerManager* InstanceManager = FindInstanceManager())
+    {
+        InstanceManager->RemoveFollower(InstanceHandle);
+    }
+    InstanceHandle = FSplineInstanceHandle();
+}
+
+// The manager may already be gone during world teardown, never spawn a new one from here
+ASplineInstancedFollowerManager* AStaticSplineFollower::FindInstanceManager() const
+{
+    const USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>();
+    return FollowerSubsystem ? FollowerSubsystem->FindInstancedFollowerManager() : nullptr;
+}
+
+void AStaticSplineFollower::OnFollowStateChanged()
+{
+    ForwardStateToInstance();
+}
+
+void AStaticSplineFollower::OnFollowedSplineChanged()
+{
+    ForwardStateToInstance();
+}
+
+// The instance derives its distance from the same state, so rebases, stops at the end and spline switches carry over
+void AStaticSplineFollower::ForwardStateToInstance()
+{
+    if (!InstanceHandle.IsValid() || !SplineComponent)
+    {
+        return;
+    }
+
+    if (ASplineInstancedFollowerManager* InstanceManager = FindInstanceManager())
+    {
+        InstanceManager->SetFollowerState(InstanceHandle, SplineComponent, GetFollowState());
+    }
+}
+
+// Replace this actor's mesh with an instance driven by the instance manager
+void AStaticSplineFollower::HandOffToInstanceManager(bool bAllowRelease)
+{
+    USplineFollowerSubsystem* FollowerSubsystem = GetWorld()->GetSubsystem<USplineFollowerSubsystem>();
+    if (!FollowerSubsystem || !SplineComponent || !StaticMeshComponent->GetStaticMesh())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s cannot use instanced rendering, falling back to its own mesh."), *GetName());
+        return;
+    }
+
+    ASplineInstancedFollowerManager* InstanceManager = FollowerSubsystem->GetInstancedFollowerManager();
+    InstanceHandle = InstanceManager->AddFollowerAtHeight(StaticMeshComponent->GetStaticMesh(), SplineComponent, GetFollowState(),
+        StaticMeshComponent->GetComponentLocation().Z);
+
+    if (!InstanceHandle.IsValid())
+    {
+        return;
+    }
+
+    // The instance takes over rendering and movement
+    SetActorTickEnabled(false);
+    StaticMeshComponent->UnregisterComponent();
+    ActiveMesh = nullptr;
+
+    // The actor can only go away when the instance does not follow this actor's own spline,
+    // and replicated actors stay so clients keep their own instance
+    const bool bOwnsFollowedSpline = SplineComponent->GetOwner() == this;
+    const bool bIsReplicatedCopy = GetIsReplicated() && GetNetMode() != NM_Standalone;
+    if (bAllowRelease && bReleaseActorWhenInstanced && !bOwnsFollowedSpline && !bIsReplicatedCopy)
+    {
+        InstanceHandle = FSplineInstanceHandle();
+        Destroy();
+    }
 }
\ No newline at end of file
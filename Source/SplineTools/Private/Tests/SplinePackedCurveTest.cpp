@@ -0,0 +1,123 @@
+#include "Misc/AutomationTest.h"
+#include "SplinePackedCurve.h"
+#include "Components/SplineComponent.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SplinePackedCurveTest
+{
+    // Location tolerance in component space units, tangents are compared relative to their length
+    static constexpr float LocationTolerance = 0.05f;
+    static constexpr float RelativeTangentTolerance = 1.0e-3f;
+
+    // Not a multiple of the lane count, so both the four lane kernel and the scalar remainder run
+    static constexpr int32 NumDistances = 4 * 32 + 3;
+
+    // Point i gets PointTypes[i % PointTypes.Num()]
+    USplineComponent* CreateSpline(TConstArrayView<ESplinePointType::Type> PointTypes, bool bClosedLoop)
+    {
+        USplineComponent* Spline = NewObject<USplineComponent>(GetTransientPackage());
+
+        const FVector Points[] = {
+            FVector(0.0f, 0.0f, 0.0f),
+            FVector(400.0f, 150.0f, 0.0f),
+            FVector(700.0f, -250.0f, 80.0f),
+            FVector(1200.0f, 0.0f, 20.0f),
+            FVector(1500.0f, 600.0f, -40.0f),
+        };
+
+        Spline->ClearSplinePoints(false);
+        for (const FVector& Point : Points)
+        {
+            Spline->AddSplinePoint(Point, ESplineCoordinateSpace::Local, false);
+        }
+        for (int32 i = 0; i < Spline->GetNumberOfSplinePoints(); ++i)
+        {
+            Spline->SetSplinePointType(i, PointTypes[i % PointTypes.Num()], false);
+        }
+        Spline->SetClosedLoop(bClosedLoop, false);
+        Spline->UpdateSpline();
+
+        return Spline;
+    }
+
+    bool TangentsMatch(const FVector& Tangent, const FVector& Expected)
+    {
+        return Tangent.Equals(Expected, FMath::Max(1.0f, Expected.Size()) * RelativeTangentTolerance);
+    }
+
+    void TestCase(FAutomationTestBase& Test, const TCHAR* Name, TConstArrayView<ESplinePointType::Type> PointTypes, bool bClosedLoop)
+    {
+        const USplineComponent* Spline = CreateSpline(PointTypes, bClosedLoop);
+
+        FSplinePackedCurve Curve;
+        Curve.Build(*Spline);
+
+        if (!Test.TestTrue(FString::Printf(TEXT("%s: curve is valid and up to date"), Name), Curve.IsValid() && Curve.IsUpToDate(*Spline)))
+        {
+            return;
+        }
+
+        // Offset from the spline points so no sample lands exactly on a point where the point type changes
+        const float SplineLength = Spline->GetSplineLength();
+        if (!Test.TestTrue(FString::Printf(TEXT("%s: spline has a length"), Name), SplineLength > 1.0f))
+        {
+            return;
+        }
+
+        TArray<float> Distances;
+        for (int32 i = 0; i < NumDistances; ++i)
+        {
+            Distances.Add((i + 0.37f) / NumDistances * SplineLength);
+        }
+
+        TArray<FVector> BatchLocations;
+        TArray<FVector> BatchTangents;
+        BatchLocations.SetNumZeroed(NumDistances);
+        BatchTangents.SetNumZeroed(NumDistances);
+        Curve.EvaluateBatch(Distances, BatchLocations, BatchTangents);
+
+        for (int32 i = 0; i < NumDistances; ++i)
+        {
+            const FVector ExpectedLocation = Spline->GetLocationAtDistanceAlongSpline(Distances[i], ESplineCoordinateSpace::Local);
+            const FVector ExpectedTangent = Spline->GetTangentAtDistanceAlongSpline(Distances[i], ESplineCoordinateSpace::Local);
+
+            FVector Location;
+            FVector Tangent;
+            Curve.Evaluate(Distances[i], Location, Tangent);
+
+            if (!Test.TestTrue(FString::Printf(TEXT("%s: scalar location at %.2f"), Name, Distances[i]), Location.Equals(ExpectedLocation, LocationTolerance))
+                || !Test.TestTrue(FString::Printf(TEXT("%s: scalar tangent at %.2f"), Name, Distances[i]), TangentsMatch(Tangent, ExpectedTangent))
+                || !Test.TestTrue(FString::Printf(TEXT("%s: batch location at %.2f"), Name, Distances[i]), BatchLocations[i].Equals(ExpectedLocation, LocationTolerance))
+                || !Test.TestTrue(FString::Printf(TEXT("%s: batch tangent at %.2f"), Name, Distances[i]), TangentsMatch(BatchTangents[i], ExpectedTangent)))
+            {
+                return;
+            }
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplinePackedCurveMatchesSplineTest, "SplineTools.PackedCurve.MatchesSpline",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSplinePackedCurveMatchesSplineTest::RunTest(const FString& Parameters)
+{
+    // Constant segments have no length to sample, the mixed cases cover segments of different types instead
+    SplinePackedCurveTest::TestCase(*this, TEXT("Linear"), { ESplinePointType::Linear }, false);
+    SplinePackedCurveTest::TestCase(*this, TEXT("Curve"), { ESplinePointType::Curve }, false);
+    SplinePackedCurveTest::TestCase(*this, TEXT("ClosedLoop"), { ESplinePointType::Curve }, true);
+    SplinePackedCurveTest::TestCase(*this, TEXT("Mixed"), { ESplinePointType::Linear, ESplinePointType::Curve, ESplinePointType::CurveClamped }, false);
+    SplinePackedCurveTest::TestCase(*this, TEXT("MixedClosedLoop"), { ESplinePointType::Curve, ESplinePointType::Linear, ESplinePointType::CurveCustomTangent }, true);
+
+    // An empty curve evaluates to zero instead of reading past its arrays
+    FSplinePackedCurve EmptyCurve;
+    FVector Location(1.0f);
+    FVector Tangent(1.0f);
+    EmptyCurve.Evaluate(100.0f, Location, Tangent);
+    TestTrue(TEXT("Empty curve evaluates to zero"), Location.IsZero() && Tangent.IsZero());
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
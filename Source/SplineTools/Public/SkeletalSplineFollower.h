@@ -5,6 +5,7 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "SplineFollowerBase.h"
+#include "SplinePoseSharingSubsystem.h"
 #include "SkeletalSplineFollower.generated.h"
 
 UCLASS()
@@ -28,6 +29,42 @@ public:
     UPROPERTY(VisibleAnywhere, Category = "Spline Properties")
     UCapsuleComponent* CapsuleComponent;
 
+    // Lower the animation update rate of distant and off-screen followers
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Animation Budget")
+    bool bUseAnimationBudgeting = false;
+
+    // Screen size thresholds at which the animation update rate drops one step further
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Animation Budget", meta = (EditCondition = "bUseAnimationBudgeting"))
+    TArray<float> VisibleDistanceFactorThresholds = { 0.4f, 0.2f, 0.1f };
+
+    // Update animation only every N frames while the follower is not rendered
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Animation Budget", meta = (ClampMin = "1", EditCondition = "bUseAnimationBudgeting"))
+    int32 NonRenderedUpdateRate = 4;
+
+    // Copy the pose of a leader on the same spline with the same mesh and animation instead of evaluating our own
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Animation Budget")
+    bool bShareLeaderPose = false;
+
+    // Followers driven by each evaluated leader pose
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Animation Budget", meta = (ClampMin = "1", EditCondition = "bShareLeaderPose"))
+    int32 FollowersPerLeaderPose = 8;
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void OnFollowedSplineChanged() override;
+
+public:
+    virtual void OnReleasedToPool() override;
+    virtual void OnAcquiredFromPool() override;
+
+private:
+    void ConfigureAnimUpdateRate(FAnimUpdateRateParameters* UpdateRateParams);
+
+    // Pose group membership follows the spline, a pooled follower must not keep driving its group
+    void JoinPoseGroup();
+    void LeavePoseGroup();
+
+    FSplinePoseGroupKey PoseGroupKey;
+    bool bInPoseGroup = false;
 };
\ No newline at end of file
@@ -5,15 +5,20 @@
 #include "Components/SplineComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "SplineTrackerActor.h"
+#include "SplineFollowerInterface.h"
+#include "SplineDistanceTable.h"
+#include "SplineCursor.h"
+#include "SplineFollowState.h"
+#include "SplineFollowerLOD.h"
 #include "SplineCharacterFollower.generated.h"
 
 UCLASS()
-class SPLINETOOLS_API ASplineCharacterFollower : public ACharacter
+class SPLINETOOLS_API ASplineCharacterFollower : public ACharacter, public ISplineFollowerInterface
 {
     GENERATED_BODY()
 
 public:
-    ASplineCharacterFollower();
+    ASplineCharacterFollower(const FObjectInitializer& ObjectInitializer);
 
     void OnConstruction(const FTransform& Transform);
 
@@ -36,6 +41,30 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Spline Properties")
     void CreateAndFollowNewSpline();
 
+    // Give this character a private copy of a shared route before changing its points
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    USplineComponent* MakeSplineUnique();
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    void SetMovementSpeed(float NewMovementSpeed);
+
+    // ISplineFollowerInterface
+    virtual USplineComponent* GetFollowedSpline() const override { return SplineComponent; }
+    virtual float GetSplinePosition() const override { return CurrentSplinePosition; }
+    virtual float GetSplineMovementSpeed() const override { return MovementSpeed; }
+    virtual bool IsFollowingSpline() const override { return FollowState.bIsFollowing; }
+    virtual const FSplineFollowState& GetFollowState() const override { return FollowState; }
+    virtual const FSplineFollowerLODSettings& GetLODSettings() const override { return LODSettings; }
+    virtual TSharedPtr<const FSplineDistanceTable> GetDistanceTable() override;
+    virtual void ApplySplineTransform(float NewSplinePosition, const FVector& Location, const FRotator& Rotation, float DeltaTime) override;
+    virtual void OnReleasedToPool() override;
+    virtual void OnAcquiredFromPool() override;
+
+    virtual bool IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const override;
+
+    // World location of the follower derived from the follow state and the server clock
+    FVector GetSplineRelevancyLocation() const;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Properties")
     bool bGlobalOverride;
 
@@ -51,6 +80,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties")
     TSubclassOf<ASplineTrackerActor> SplineActorClass;
 
+    // Follow one route spline shared by every follower with the same points instead of spawning a SplineActorClass copy
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance")
+    bool bShareRoute = true;
+
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties")
     bool bFollowSplineAtRandomPosition = false;
 
@@ -66,22 +99,84 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties")
     float Tolerance = 0.05f;
 
+    // Let the USplineFollowerSubsystem advance this character instead of ticking the actor
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance")
+    bool bUseBatchedUpdate = true;
+
+    // Sample a baked, uniformly spaced distance table instead of evaluating the spline curve every frame
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance")
+    bool bUseBakedDistanceTable = true;
+
+    // Initial distance between baked samples, halved until BakedMaxError is met
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance", meta = (ClampMin = "1.0", EditCondition = "bUseBakedDistanceTable"))
+    float BakedSampleSpacing = 50.0f;
+
+    // Maximum allowed distance between the baked table and the real spline curve
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance", meta = (ClampMin = "0.01", EditCondition = "bUseBakedDistanceTable"))
+    float BakedMaxError = 1.0f;
+
+    // Bits used to replicate the start distance as a fraction of the spline length, 16 bits is about 1.5cm on a 1km spline
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Networking", meta = (ClampMin = "8", ClampMax = "24"))
+    uint8 DistanceQuantizationBits = 16;
+
+    // Let the USplineMovementComponent hand the character to the spline, without character movement simulation or movement replication
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance")
+    bool bMoveOnRails = true;
+
+    // Lower update rate for far or off-screen followers, culled followers skip their transform
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Performance")
+    FSplineFollowerLODSettings LODSettings;
+
+    // Keep the follower dormant on the server and only wake it up when its follow state changes
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Networking")
+    bool bUseNetDormancy = true;
+
+    // Cull by the follower's position on the spline instead of the actor transform
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Networking")
+    bool bUseSplineRelevancy = true;
+
 protected:
     virtual void BeginPlay() override;
 
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     void BeginDestroy();
 
+    // Pick the start distance from the random or fixed start settings
+    void ResetStartPosition();
+
     void UpdateSplinePosition(float DeltaTime);
 
+    // Derive the distance along the spline from the follow state and the server clock
+    void UpdateSplinePositionFromState();
+
+    // Restart the follow state from the current distance, server only
+    void RebaseFollowState(bool bFollowing);
+
+    // Push changed follow state to the batched subsystem
+    void RefreshBatchedState();
+
+    // Apply the LOD bands from the actor tick, DeltaTime becomes the time since the last update
+    bool ConsumeLODFrame(float& DeltaTime);
+
+    // Evaluate the followed spline in world space
+    void EvaluateSplineAtDistance(float Distance, FVector& OutLocation, FRotator& OutRotation);
+
     // Predict client-side movement
     void PredictClientMovement(float DeltaTime);
 
+    void FollowSharedRoute();
+    void ReleaseSpawnedSplineActor();
+
+    // Move to a spline transform, through the spline movement component while on rails
+    void MoveCharacterTo(const FVector& NewLocation, const FRotator& NewRotation, float DeltaTime, ETeleportType Teleport);
+
     // Interpolate the movement for smooth transitions
     void InterpolateMovement(FVector TargetLocation, FRotator TargetRotation, float DeltaTime);
 
-    // Handle replication of the spline position
+    // Handle replication of the follow state
     UFUNCTION()
-    void OnRep_CurrentSplinePosition();
+    void OnRep_FollowState();
 
     // Declare properties to replicate
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
@@ -90,9 +185,18 @@ private:
     UPROPERTY()
     ASplineTrackerActor* SpawnedSplineActor;
 
-    UPROPERTY(ReplicatedUsing = OnRep_CurrentSplinePosition)
+    // Shared route acquired from the USplineFollowerSubsystem, released in EndPlay
+    UPROPERTY()
+    USplineComponent* SharedRoute = nullptr;
+
+    TSharedPtr<const FSplineDistanceTable> DistanceTable;
+    FSplineCursor SplineCursor;
+
+    FSplineFollowerLODTicker LODTicker;
+
+    // Derived every frame from FollowState on both server and clients
     float CurrentSplinePosition;
 
-    UPROPERTY(Replicated)
-    bool bIsFollowing;
+    UPROPERTY(ReplicatedUsing = OnRep_FollowState)
+    FSplineFollowState FollowState;
 };
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USplineComponent;
+
+// Remembers where a follower was on the spline's distance reparam table so forward movement
+// only steps over the entries it passed instead of searching the whole table every frame
+struct SPLINETOOLS_API FSplineCursor
+{
+    // Spline input key at Distance, stepping forward from the last lookup when possible
+    float GetInputKeyAtDistance(const USplineComponent& Spline, float Distance);
+
+    // World transform at Distance through the cursor
+    void EvaluateWorld(const USplineComponent& Spline, float Distance, FVector& OutLocation, FRotator& OutRotation);
+
+    // Force the next lookup to do a full search
+    void Reset() { ReparamIndex = INDEX_NONE; }
+
+private:
+    int32 FindReparamIndex(const USplineComponent& Spline, float Distance) const;
+
+    int32 ReparamIndex = INDEX_NONE;
+    float LastDistance = 0.0f;
+    uint32 SplineVersion = 0;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SplineComponent.h"
+
+// Component settings a spline's reparam table is baked with
+struct SPLINETOOLS_API FSplineCurveBakeSettings
+{
+    bool bClosedLoop = false;
+    bool bStationaryEndpoints = false;
+    int32 ReparamStepsPerSegment = 10;
+    FVector Scale3D = FVector::OneVector;
+
+    FSplineCurveBakeSettings() = default;
+    explicit FSplineCurveBakeSettings(const USplineComponent& Spline);
+
+    bool operator==(const FSplineCurveBakeSettings& Other) const;
+};
+
+// Copies whole spline curves, positions with tangents and point types, rotations, scales and the reparam
+// table, as array blocks instead of point by point
+struct SPLINETOOLS_API FSplineCurveCopy
+{
+    // Copy Source into Target. The reparam table of Source is reused when allowed and baked with the same
+    // settings, otherwise it is rebuilt for TargetSettings. Does not touch any component, safe off the game thread
+    static void CopyCurves(const FSplineCurves& Source, const FSplineCurveBakeSettings& SourceSettings,
+        FSplineCurves& Target, const FSplineCurveBakeSettings& TargetSettings, bool bReuseReparamTable = true);
+
+    // Hand curves made by CopyCurves to a component, its version keeps increasing so cached tables are rebuilt
+    static void AssignCurves(USplineComponent& Target, FSplineCurves&& Curves);
+
+    // Exact copy of Source, Target also takes over its closed loop, endpoint and reparam settings
+    static void Copy(const USplineComponent& Source, USplineComponent& Target, bool bReuseReparamTable = true);
+
+    // Hash of positions with tangents and point types, rotations, scales and the loop setting. Equal curves
+    // hash equal, callers that must not mix up different curves compare them on a match
+    static uint32 HashCurves(const FSplineCurves& Curves);
+};
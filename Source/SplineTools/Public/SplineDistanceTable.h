@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class USplineComponent;
+struct FSplinePackedCurve;
+
+// Spline positions and rotations baked at uniform distance steps in component space,
+// so a distance can be evaluated with a direct index instead of a reparam search
+struct SPLINETOOLS_API FSplineDistanceTable
+{
+    // Bake the spline, halving the spacing until the midpoint error is below MaxError or MinSampleSpacing is reached
+    void Build(const USplineComponent& Spline, float InSampleSpacing, float MaxError, float MinSampleSpacing = 1.0f);
+
+    // Take samples baked elsewhere, spaced evenly over InSplineLength. Such a table is never up to date with a spline
+    void InitFromSamples(TConstArrayView<FVector3f> InLocations, TConstArrayView<FQuat4f> InRotations, float InSplineLength);
+
+    // True when the table was baked from this spline and its current curve data
+    bool IsUpToDate(const USplineComponent& Spline) const;
+
+    bool IsValid() const { return Locations.Num() >= 2; }
+
+    // Sample in component space
+    void Sample(float Distance, FVector& OutLocation, FQuat& OutRotation) const;
+
+    // Sample and transform into world space
+    void SampleWorld(float Distance, const FTransform& ComponentToWorld, FVector& OutLocation, FRotator& OutRotation) const;
+
+    float GetSplineLength() const { return SplineLength; }
+    float GetSampleSpacing() const { return SampleSpacing; }
+
+    const TArray<FVector>& GetLocations() const { return Locations; }
+    const TArray<FQuat>& GetRotations() const { return Rotations; }
+
+private:
+    // Locations come from PackedCurve when it is set, rotations always from the spline
+    void BakeSamples(const USplineComponent& Spline, const FSplinePackedCurve* PackedCurve, int32 NumSamples);
+    float MeasureMaxError(const USplineComponent& Spline, const FSplinePackedCurve* PackedCurve) const;
+
+    TArray<FVector> Locations;
+    TArray<FQuat> Rotations;
+
+    float SplineLength = 0.0f;
+    float SampleSpacing = 0.0f;
+    float InvSampleSpacing = 0.0f;
+
+    // Spline, curve version and point count the table was baked from
+    TObjectKey<USplineComponent> SourceSpline;
+    uint32 SplineVersion = 0;
+    int32 NumSplinePoints = 0;
+    bool bClosedLoop = false;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SplineFollowState.generated.h"
+
+class UWorld;
+
+// Distance along a spline sent as a fraction of the spline length, quantized to NumBits
+USTRUCT(BlueprintType)
+struct SPLINETOOLS_API FSplineQuantizedDistance
+{
+    GENERATED_BODY()
+
+    static constexpr uint8 MinBits = 8;
+    static constexpr uint8 MaxBits = 24;
+
+    // Fraction of the spline length, already rounded to the precision it is sent with
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    float Alpha = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    uint8 NumBits = 16;
+
+    void Set(float Distance, float SplineLength, uint8 InNumBits);
+
+    float Get(float SplineLength) const { return Alpha * SplineLength; }
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+    bool operator==(const FSplineQuantizedDistance& Other) const
+    {
+        return Alpha == Other.Alpha && NumBits == Other.NumBits;
+    }
+
+    bool operator!=(const FSplineQuantizedDistance& Other) const
+    {
+        return !(*this == Other);
+    }
+
+private:
+    static uint32 GetMaxQuantizedValue(uint8 Bits) { return (1u << Bits) - 1u; }
+};
+
+template<>
+struct TStructOpsTypeTraits<FSplineQuantizedDistance> : public TStructOpsTypeTraitsBase2<FSplineQuantizedDistance>
+{
+    enum
+    {
+        WithNetSerializer = true,
+        WithIdenticalViaEquality = true,
+    };
+};
+
+// Replicated description of a follower's motion. Position is derived from the synchronized
+// server clock, so the state only changes when a follower starts, stops or changes speed
+USTRUCT(BlueprintType)
+struct SPLINETOOLS_API FSplineFollowState
+{
+    GENERATED_BODY()
+
+    // Distance along the spline at StartServerTime
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    FSplineQuantizedDistance StartDistance;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    double StartServerTime = 0.0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    float Speed = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    bool bIsFollowing = false;
+
+    // Stop at the end of the spline instead of looping, used for routes through a spline network
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    bool bStopAtEnd = false;
+
+    // Distance at ServerTime, wrapped to or clamped at the spline length
+    float GetDistanceAtTime(double ServerTime, float SplineLength) const
+    {
+        return EvaluateDistance(StartDistance.Get(SplineLength), StartServerTime, bIsFollowing ? Speed : 0.0f, ServerTime, SplineLength, !bStopAtEnd);
+    }
+
+    static float EvaluateDistance(float StartDistance, double StartServerTime, float Speed, double ServerTime, float SplineLength, bool bLoop = true);
+
+    // Server world time as seen by this machine, falling back to local time without a game state
+    static double GetServerTime(const UWorld* World);
+};
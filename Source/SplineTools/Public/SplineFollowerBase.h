@@ -6,10 +6,33 @@
 #include "Components/MeshComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "SplineTrackerActor.h"
+#include "SplineFollowerInterface.h"
+#include "SplineDistanceTable.h"
+#include "SplineCursor.h"
+#include "SplineFollowState.h"
+#include "SplineFollowerLOD.h"
 #include "SplineFollowerBase.generated.h"
 
+class ASplineNetwork;
+
+// Route through a spline network, replicated instead of the route spline which every machine builds itself
+USTRUCT()
+struct FSplineNetworkRoute
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    ASplineNetwork* Network = nullptr;
+
+    UPROPERTY()
+    int32 FromNode = INDEX_NONE;
+
+    UPROPERTY()
+    int32 ToNode = INDEX_NONE;
+};
+
 UCLASS()
-class SPLINETOOLS_API ASplineFollowerBase : public ASplineTrackerActor
+class SPLINETOOLS_API ASplineFollowerBase : public ASplineTrackerActor, public ISplineFollowerInterface
 {
     GENERATED_BODY()
 
@@ -21,6 +44,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void OnConstruction(const FTransform& Transform) override;
 
 public:
@@ -35,6 +59,34 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Spline Properties")
     void SetSplineComponent(USplineComponent* Spline);
 
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    void SetMovementSpeed(float NewMovementSpeed);
+
+    // Follow the cheapest route between two junctions of Network and stop at its end. Server only
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    bool FollowNetworkRoute(ASplineNetwork* Network, int32 FromNode, int32 ToNode);
+
+    // Continue the motion of something else on the same spline, e.g. the Mass entity this actor represents.
+    // In a networked game Spline has to be supported for networking so clients can resolve it
+    void AdoptFollowState(USplineComponent* Spline, const FSplineFollowState& NewFollowState);
+
+    // ISplineFollowerInterface
+    virtual USplineComponent* GetFollowedSpline() const override { return SplineComponent; }
+    virtual float GetSplinePosition() const override { return CurrentSplinePosition; }
+    virtual float GetSplineMovementSpeed() const override { return MovementSpeed; }
+    virtual bool IsFollowingSpline() const override { return FollowState.bIsFollowing; }
+    virtual const FSplineFollowState& GetFollowState() const override { return FollowState; }
+    virtual const FSplineFollowerLODSettings& GetLODSettings() const override { return LODSettings; }
+    virtual TSharedPtr<const FSplineDistanceTable> GetDistanceTable() override;
+    virtual void ApplySplineTransform(float NewSplinePosition, const FVector& Location, const FRotator& Rotation, float DeltaTime) override;
+    virtual void OnReleasedToPool() override;
+    virtual void OnAcquiredFromPool() override;
+
+    virtual bool IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const override;
+
+    // World location of the follower derived from the follow state and the server clock
+    FVector GetSplineRelevancyLocation() const;
+
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties")
     bool bFollowSplineAtRandomPosition = false;
 
@@ -50,26 +102,112 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Properties")
     bool bStartFollowOnBeginPlay = true;
 
+    // Use SetMovementSpeed at runtime so batched followers pick up the change
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Properties")
     float MovementSpeed = 100.0f;
 
+    // Let the USplineFollowerSubsystem advance this follower instead of ticking the actor
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance")
+    bool bUseBatchedUpdate = true;
+
+    // Sample a baked, uniformly spaced distance table instead of evaluating the spline curve every frame
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance")
+    bool bUseBakedDistanceTable = true;
+
+    // Initial distance between baked samples, halved until BakedMaxError is met
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance", meta = (ClampMin = "1.0", EditCondition = "bUseBakedDistanceTable"))
+    float BakedSampleSpacing = 50.0f;
+
+    // Maximum allowed distance between the baked table and the real spline curve
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance", meta = (ClampMin = "0.01", EditCondition = "bUseBakedDistanceTable"))
+    float BakedMaxError = 1.0f;
+
+    // Bits used to replicate the start distance as a fraction of the spline length, 16 bits is about 1.5cm on a 1km spline
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Networking", meta = (ClampMin = "8", ClampMax = "24"))
+    uint8 DistanceQuantizationBits = 16;
+
+    // Move the mesh without syncing its physics bodies when it and its attached colliders are query-only.
+    // Traces see the bodies where they were last synced, which happens whenever the follower is teleported
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Performance")
+    bool bSkipPhysicsStateSync = false;
+
+    // Lower update rate for far or off-screen followers, culled followers skip their transform
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Performance")
+    FSplineFollowerLODSettings LODSettings;
+
+    // Keep the follower dormant on the server and only wake it up when its follow state changes
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Networking")
+    bool bUseNetDormancy = true;
+
+    // Cull by the follower's position on the spline instead of the actor transform
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spline Properties|Networking")
+    bool bUseSplineRelevancy = true;
+
     UPROPERTY(EditAnywhere, Category = "Spline Properties")
     UMeshComponent* ActiveMesh;
 
 protected:
+    void ResetStartPosition();
     void UpdateSplinePosition(float DeltaTime);
     void PredictClientMovement(float DeltaTime);
+    void UpdateSplinePositionFromState();
+    void RebaseFollowState(bool bFollowing);
+    void MoveToSplinePosition();
+    void SnapMeshTo(const FVector& NewLocation, const FRotator& NewRotation);
+    void CommitMeshTransform(const FVector& NewLocation, const FQuat& NewRotation, ETeleportType Teleport);
+    bool HasQueryOnlyCollision() const;
+    void PredictToSplinePosition(float DeltaTime);
+    void RefreshBatchedState();
+
+    // Apply the LOD bands from the actor tick, DeltaTime becomes the time since the last update
+    bool ConsumeLODFrame(float& DeltaTime);
+    void EvaluateSplineAtDistance(float Distance, FVector& OutLocation, FRotator& OutRotation);
     void InterpolateMovement(FVector TargetLocation, FRotator TargetRotation, float DeltaTime);
 
     UFUNCTION()
-    void OnRep_CurrentSplinePosition();
+    void OnRep_FollowState();
+
+    UFUNCTION()
+    void OnRep_NetworkRoute();
+
+    UFUNCTION()
+    void OnRep_AdoptedSpline();
+
+    // Switch to the route spline of NetworkRoute, again after the network was rebuilt
+    void ApplyNetworkRoute();
+
+    // Called after the follow state was rebased on the server or replicated to a client
+    virtual void OnFollowStateChanged() {}
+
+    // Called after SetSplineComponent switched the followed spline, e.g. to a route or adopted spline
+    virtual void OnFollowedSplineChanged() {}
 
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 private:
-    UPROPERTY(ReplicatedUsing = OnRep_CurrentSplinePosition)
-    float CurrentSplinePosition;
+    TSharedPtr<const FSplineDistanceTable> DistanceTable;
+    FSplineCursor SplineCursor;
+
+    bool bCanSkipPhysicsStateSync = false;
+
+    FSplineFollowerLODTicker LODTicker;
+
+    // Derived every frame from FollowState on both server and clients
+    float CurrentSplinePosition = 0.0f;
+
+    UPROPERTY(ReplicatedUsing = OnRep_FollowState)
+    FSplineFollowState FollowState;
+
+    UPROPERTY(ReplicatedUsing = OnRep_NetworkRoute)
+    FSplineNetworkRoute NetworkRoute;
+
+    // Spline passed to AdoptFollowState, replicated since the followed spline component is not
+    UPROPERTY(ReplicatedUsing = OnRep_AdoptedSpline)
+    USplineComponent* AdoptedSpline = nullptr;
+
+    // Spline component created with the actor, followed again once an adopted or route spline is dropped
+    UPROPERTY()
+    USplineComponent* OwnSplineComponent = nullptr;
 
-    UPROPERTY(Replicated)
-    bool bIsFollowing;
+    FDelegateHandle NetworkChangedHandle;
 };
\ No newline at end of file
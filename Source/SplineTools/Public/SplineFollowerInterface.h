@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "SplineFollowerInterface.generated.h"
+
+class AActor;
+class USplineComponent;
+struct FSplineDistanceTable;
+struct FSplineFollowState;
+struct FSplineFollowerLODSettings;
+
+UINTERFACE(MinimalAPI)
+class USplineFollowerInterface : public UInterface
+{
+    GENERATED_BODY()
+};
+
+// Implemented by actors that can be advanced along a spline by the USplineFollowerSubsystem
+class SPLINETOOLS_API ISplineFollowerInterface
+{
+    GENERATED_BODY()
+
+public:
+    // Spline the follower is currently moving along
+    virtual USplineComponent* GetFollowedSpline() const = 0;
+
+    // Current distance along the followed spline
+    virtual float GetSplinePosition() const = 0;
+
+    // Distance travelled along the spline per second
+    virtual float GetSplineMovementSpeed() const = 0;
+
+    virtual bool IsFollowingSpline() const = 0;
+
+    // Replicated motion the subsystem derives the distance from each frame
+    virtual const FSplineFollowState& GetFollowState() const = 0;
+
+    // Distance bands the subsystem uses to lower the follower's update rate
+    virtual const FSplineFollowerLODSettings& GetLODSettings() const = 0;
+
+    // Baked distance table the subsystem may sample off the game thread, null to evaluate the spline directly
+    virtual TSharedPtr<const FSplineDistanceTable> GetDistanceTable() = 0;
+
+    // Called by the subsystem on the game thread with the derived distance and its world transform
+    virtual void ApplySplineTransform(float NewSplinePosition, const FVector& Location, const FRotator& Rotation, float DeltaTime) = 0;
+
+    // Called by USplineFollowerPoolSubsystem when the follower is parked in or taken back out of a pool
+    virtual void OnReleasedToPool() {}
+    virtual void OnAcquiredFromPool() {}
+
+    // Index of the follower inside the subsystem's batched arrays
+    int32 GetSplineBatchHandle() const { return SplineBatchHandle; }
+    void SetSplineBatchHandle(int32 NewHandle) { SplineBatchHandle = NewHandle; }
+
+protected:
+    // Distance culling against the position on the spline, unset when the actor's own relevancy check applies
+    TOptional<bool> IsSplineNetRelevantFor(const AActor& Actor, bool bUseSplineRelevancy, const AActor* RealViewer, const AActor* ViewTarget,
+        const FVector& SrcLocation, const FSplineDistanceTable* Table) const;
+
+    // World location derived from the follow state and the server clock, sampled from Table while it is up to date
+    FVector ComputeSplineRelevancyLocation(const AActor& Actor, const FSplineDistanceTable* Table) const;
+
+    // Leave the batched update and hide Actor without any per-frame work, shared part of OnReleasedToPool
+    void ParkInPool(AActor& Actor);
+
+    // Show Actor again and hand it back to the batched update or its own tick, shared part of OnAcquiredFromPool
+    void UnparkFromPool(AActor& Actor, bool bUseBatchedUpdate);
+
+private:
+    int32 SplineBatchHandle = INDEX_NONE;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SplineFollowerLOD.generated.h"
+
+class AActor;
+
+// Followers closer to a viewer than MaxDistance update every UpdateInterval frames
+USTRUCT(BlueprintType)
+struct SPLINETOOLS_API FSplineFollowerLODBand
+{
+    GENERATED_BODY()
+
+    FSplineFollowerLODBand() = default;
+    FSplineFollowerLODBand(float InMaxDistance, int32 InUpdateInterval)
+        : MaxDistance(InMaxDistance)
+        , UpdateInterval(InUpdateInterval)
+    {
+    }
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties", meta = (ClampMin = "0.0"))
+    float MaxDistance = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties", meta = (ClampMin = "1", ClampMax = "255"))
+    int32 UpdateInterval = 1;
+};
+
+// Distance and visibility based update rate of a spline follower
+USTRUCT(BlueprintType)
+struct SPLINETOOLS_API FSplineFollowerLODSettings
+{
+    GENERATED_BODY()
+
+    FSplineFollowerLODSettings()
+    {
+        Bands.Add(FSplineFollowerLODBand(4000.0f, 1));
+        Bands.Add(FSplineFollowerLODBand(10000.0f, 2));
+        Bands.Add(FSplineFollowerLODBand(25000.0f, 4));
+    }
+
+    // Followers rendered within this many seconds count as visible
+    static constexpr float RecentlyRenderedTime = 0.25f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties")
+    bool bEnabled = true;
+
+    // Sorted by MaxDistance, followers beyond the last band are culled
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties", meta = (EditCondition = "bEnabled"))
+    TArray<FSplineFollowerLODBand> Bands;
+
+    // Minimum interval for followers inside a band that were not rendered recently
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties", meta = (ClampMin = "1", ClampMax = "255", EditCondition = "bEnabled"))
+    int32 OffscreenUpdateInterval = 4;
+
+    // Culled followers skip their transform and only re-evaluate their position this often to pick a band again
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties", meta = (ClampMin = "1", ClampMax = "255", EditCondition = "bEnabled"))
+    int32 CulledUpdateInterval = 15;
+
+    // True on one of every Interval frames, followers with different phases update on different frames
+    static bool IsUpdateFrame(int32 Interval, uint32 Phase)
+    {
+        return (GFrameCounter + Phase) % static_cast<uint64>(FMath::Max(Interval, 1)) == 0;
+    }
+
+    // Frames between updates, 0 when the follower is culled
+    int32 GetUpdateInterval(float ViewerDistanceSquared, bool bRecentlyRendered) const
+    {
+        if (!bEnabled || Bands.Num() == 0)
+        {
+            return 1;
+        }
+
+        for (const FSplineFollowerLODBand& Band : Bands)
+        {
+            if (ViewerDistanceSquared <= FMath::Square(Band.MaxDistance))
+            {
+                const int32 Interval = FMath::Clamp(Band.UpdateInterval, 1, 255);
+                return bRecentlyRendered ? Interval : FMath::Max(Interval, FMath::Clamp(OffscreenUpdateInterval, 1, 255));
+            }
+        }
+
+        return 0;
+    }
+};
+
+// LOD bookkeeping of a follower that ticks itself, the USplineFollowerSubsystem applies the same bands to batched followers
+struct SPLINETOOLS_API FSplineFollowerLODTicker
+{
+    // True when Actor should update this frame, DeltaTime becomes the time since its last update
+    bool ConsumeFrame(const AActor& Actor, const FSplineFollowerLODSettings& Settings, const FVector& FollowerLocation, float& DeltaTime);
+
+private:
+    float PendingDeltaTime = 0.0f;
+};
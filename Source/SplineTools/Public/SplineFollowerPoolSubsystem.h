@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SplineFollowerPoolSubsystem.generated.h"
+
+class ASplineTrackerActor;
+
+// Inactive actors of one class waiting to be reused
+USTRUCT()
+struct FSplineActorPool
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<AActor*> Actors;
+};
+
+USTRUCT(BlueprintType)
+struct SPLINETOOLS_API FSplineFollowerPoolStats
+{
+    GENERATED_BODY()
+
+    // Acquisitions served from a pool
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    int32 Hits = 0;
+
+    // Acquisitions that had to spawn a new actor
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    int32 Misses = 0;
+
+    // Actors currently parked in all pools
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    int32 NumPooled = 0;
+};
+
+// Recycles spline followers and spline tracker actors per class instead of spawning and destroying them.
+// Followers implementing ISplineFollowerInterface reset their spline position and follow state when reused
+UCLASS()
+class SPLINETOOLS_API USplineFollowerPoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Deinitialize() override;
+
+    // Spawn actors of Class into its pool until it holds at least Count actors
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    void Prewarm(TSubclassOf<AActor> Class, int32 Count);
+
+    // Take an actor of Class from its pool, or spawn one when the pool is empty
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    AActor* AcquireActor(TSubclassOf<AActor> Class, const FTransform& Transform);
+
+    // Park an actor acquired from this subsystem, it stops following and is hidden until acquired again
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    void ReleaseActor(AActor* Actor);
+
+    template<typename T>
+    T* Acquire(TSubclassOf<T> Class, const FTransform& Transform)
+    {
+        return Cast<T>(AcquireActor(Class, Transform));
+    }
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    FSplineFollowerPoolStats GetPoolStats() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    void ResetPoolStats();
+
+private:
+    AActor* SpawnPooledActor(UClass* Class, const FTransform& Transform);
+    void Deactivate(AActor* Actor);
+    void Activate(AActor* Actor, const FTransform& Transform);
+
+    // Parked trackers must not show up in nearest spline and radius queries
+    void UpdateSpatialIndex(AActor* Actor, bool bParked);
+
+    UPROPERTY()
+    TMap<UClass*, FSplineActorPool> Pools;
+
+    int32 Hits = 0;
+    int32 Misses = 0;
+};
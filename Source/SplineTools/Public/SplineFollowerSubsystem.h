@@ -0,0 +1,159 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "SplineDistanceTable.h"
+#include "SplineCursor.h"
+#include "SplineFollowState.h"
+#include "SplineFollowerLOD.h"
+#include "SplineCurveCopy.h"
+#include "SplineFollowerSubsystem.generated.h"
+
+class AActor;
+class USplineComponent;
+class ISplineFollowerInterface;
+class ASplineInstancedFollowerManager;
+
+// Curves, bake settings and placement of a route, followers on equal routes share one spline component
+struct SPLINETOOLS_API FSplineRouteKey
+{
+    FSplineCurves Curves;
+    FSplineCurveBakeSettings Settings;
+    FTransform ComponentTransform;
+    uint32 Hash = 0;
+
+    static FSplineRouteKey FromSpline(const USplineComponent& Spline);
+
+    // The hash only narrows the search, equal routes need the same tangents, rotations, scales and point types
+    bool operator==(const FSplineRouteKey& Other) const
+    {
+        return Hash == Other.Hash && Settings == Other.Settings && ComponentTransform.Equals(Other.ComponentTransform, 0.0)
+            && Curves == Other.Curves;
+    }
+
+    friend uint32 GetTypeHash(const FSplineRouteKey& Key)
+    {
+        return Key.Hash;
+    }
+};
+
+// Advances every registered spline follower in a single batched pass per frame. Distances and
+// target transforms are computed in parallel, then applied to the followers on the game thread
+UCLASS()
+class SPLINETOOLS_API USplineFollowerSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Deinitialize() override;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Add a follower to the batched update, the follower should disable its own tick afterwards
+    void RegisterFollower(AActor* FollowerActor);
+    void UnregisterFollower(AActor* FollowerActor);
+
+    // Re-read spline and follow state after the follower changed them
+    void RefreshFollower(AActor* FollowerActor);
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    int32 GetNumRegisteredFollowers() const { return Distances.Num(); }
+
+    // Squared distance to the closest player view point gathered this frame, 0 without any viewer
+    float GetClosestViewerDistanceSquared(const FVector& Location) const;
+
+    // Player view points gathered this frame
+    const TArray<FVector>& GetViewerLocations() const { return ViewerLocations; }
+
+    // Shared baked distance table for a spline, rebuilt only when the spline's curve data changed
+    TSharedPtr<const FSplineDistanceTable> FindOrBuildDistanceTable(const USplineComponent* Spline, float SampleSpacing, float MaxError);
+
+    // Reference counted spline with the same world space points as Source, created on the first request
+    USplineComponent* AcquireSharedRoute(const USplineComponent* Source);
+
+    // Drop one reference to a shared or private route, the route is destroyed with its last reference
+    void ReleaseSharedRoute(USplineComponent* Route);
+
+    // Copy on write, returns a private copy when Route is shared with other followers and releases Route
+    USplineComponent* MakeRouteUnique(USplineComponent* Route);
+
+    // Manager that renders instanced static followers, spawned on first use
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    ASplineInstancedFollowerManager* GetInstancedFollowerManager();
+
+    // Manager that renders instanced static followers, null when none was spawned yet
+    ASplineInstancedFollowerManager* FindInstancedFollowerManager() const;
+
+private:
+    enum EFollowerFlags : uint8
+    {
+        None = 0,
+        Following = 1 << 0,
+        StopAtEnd = 1 << 1,
+    };
+
+    enum EUpdateMode : uint8
+    {
+        Skip,
+        EvaluateOnly,
+        Apply,
+    };
+
+    void GatherViewerLocations();
+    EUpdateMode SelectUpdateMode(int32 Index);
+
+    USplineComponent* CreateRouteSpline(const USplineComponent& Source);
+
+    void ReadFollowerState(int32 Index);
+    void RemoveFollowerAtSwap(int32 Index);
+
+    // Structure-of-arrays follower state, indexed by each follower's batch handle
+    TArray<ISplineFollowerInterface*> Followers;
+    TArray<TWeakObjectPtr<AActor>> FollowerActors;
+    TArray<TWeakObjectPtr<USplineComponent>> Splines;
+    TArray<float> Distances;
+    // Start distance as a fraction of the spline length, as replicated
+    TArray<float> StartAlphas;
+    TArray<double> StartTimes;
+    TArray<float> Speeds;
+    TArray<uint8> Flags;
+    TArray<TSharedPtr<const FSplineDistanceTable>> Tables;
+    TArray<FSplineCursor> Cursors;
+    TArray<const FSplineFollowerLODSettings*> LODSettings;
+
+    // Last evaluated transform, also used to pick the LOD band
+    TArray<FVector> TargetLocations;
+    TArray<FRotator> TargetRotations;
+
+    // Time since the transform was last applied
+    TArray<float> PendingDeltaTimes;
+
+    // Per-frame buffers filled before the parallel evaluation pass
+    TArray<const USplineComponent*> ResolvedSplines;
+    TArray<uint8> UpdateModes;
+    TArray<FVector> ViewerLocations;
+
+    // Baked distance tables shared by every follower on the same spline
+    TMap<TObjectKey<USplineComponent>, TSharedPtr<FSplineDistanceTable>> DistanceTables;
+
+    struct FSharedRoute
+    {
+        USplineComponent* Spline = nullptr;
+        int32 RefCount = 0;
+    };
+
+    // Route splines by their points, private copies are only counted in RouteRefCounts
+    TMap<FSplineRouteKey, FSharedRoute> SharedRoutes;
+    TMap<TObjectKey<USplineComponent>, FSplineRouteKey> SharedRouteKeys;
+    TMap<TObjectKey<USplineComponent>, int32> PrivateRouteRefCounts;
+
+    // Owns every route spline component
+    UPROPERTY()
+    AActor* RouteHost = nullptr;
+
+    UPROPERTY()
+    ASplineInstancedFollowerManager* InstancedFollowerManager = nullptr;
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "UObject/ObjectKey.h"
+#include "SplineDistanceTable.h"
+#include "SplineFollowState.h"
+#include "SplineInstancedFollowerManager.generated.h"
+
+class UStaticMesh;
+class USplineComponent;
+class UInstancedStaticMeshComponent;
+
+// Identifies one instanced follower inside an ASplineInstancedFollowerManager
+USTRUCT(BlueprintType)
+struct SPLINETOOLS_API FSplineInstanceHandle
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    int32 GroupIndex = INDEX_NONE;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    int32 InstanceIndex = INDEX_NONE;
+
+    bool IsValid() const { return GroupIndex != INDEX_NONE && InstanceIndex != INDEX_NONE; }
+};
+
+// Moves many static meshes along splines as instances of one instanced mesh component per mesh,
+// without an actor or component per follower. Instanced followers are simulated locally on every machine,
+// their distance is derived from an FSplineFollowState and the server clock like that of ASplineFollowerBase.
+UCLASS(NotPlaceable)
+class SPLINETOOLS_API ASplineInstancedFollowerManager : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    ASplineInstancedFollowerManager();
+
+    virtual void Tick(float DeltaTime) override;
+
+    // Add a lightweight follower rendered as an instance of Mesh, starting at StartDistance now
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    FSplineInstanceHandle AddFollower(UStaticMesh* Mesh, USplineComponent* Spline, float StartDistance, float Speed, bool bFollowing = true);
+
+    // Add a follower that continues the given follow state, e.g. the one of a replicated follower actor
+    FSplineInstanceHandle AddFollowerWithState(UStaticMesh* Mesh, USplineComponent* Spline, const FSplineFollowState& State);
+
+    // Same as AddFollowerWithState but keeps the instance at a fixed world height, like ASplineFollowerBase does for its mesh
+    FSplineInstanceHandle AddFollowerAtHeight(UStaticMesh* Mesh, USplineComponent* Spline, const FSplineFollowState& State, float FixedHeight);
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    void RemoveFollower(FSplineInstanceHandle Handle);
+
+    // Replace the spline and the whole follow state of a follower
+    void SetFollowerState(FSplineInstanceHandle Handle, USplineComponent* Spline, const FSplineFollowState& State);
+
+    // Restart the follow state from the current distance with the new speed
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    void SetFollowerSpeed(FSplineInstanceHandle Handle, float Speed);
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    void SetFollowerFollowing(FSplineInstanceHandle Handle, bool bFollowing);
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    int32 GetNumInstancedFollowers() const;
+
+    // Baked table settings used for every instanced follower
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance")
+    float BakedSampleSpacing = 50.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance")
+    float BakedMaxError = 1.0f;
+
+private:
+    enum EInstanceFlags : uint8
+    {
+        None = 0,
+        Active = 1 << 0,
+        KeepHeight = 1 << 1,
+    };
+
+    // All instances of one mesh, indexed by instance index
+    struct FInstanceGroup
+    {
+        UInstancedStaticMeshComponent* Component = nullptr;
+
+        TArray<TWeakObjectPtr<USplineComponent>> Splines;
+        TArray<TSharedPtr<const FSplineDistanceTable>> Tables;
+        TArray<FSplineFollowState> States;
+        TArray<float> Heights;
+        TArray<uint8> Flags;
+
+        // Removed instances are hidden and reused instead of shifting the instance buffer
+        TArray<int32> FreeIndices;
+
+        // Per-frame buffers for the parallel update
+        TArray<const USplineComponent*> ResolvedSplines;
+        TArray<FTransform> InstanceTransforms;
+    };
+
+    int32 FindOrAddGroup(UStaticMesh* Mesh);
+    FInstanceGroup* FindGroup(const FSplineInstanceHandle& Handle);
+    void UpdateGroup(int32 GroupIndex, double ServerTime);
+
+    // Anchor the follow state of an instance at its current distance and the current server time
+    void RebaseFollower(FInstanceGroup& Group, int32 Index, float Speed, bool bFollowing);
+
+    TArray<FInstanceGroup> Groups;
+    TMap<TObjectKey<UStaticMesh>, int32> GroupByMesh;
+
+    UPROPERTY()
+    TArray<UInstancedStaticMeshComponent*> InstanceComponents;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SplineDistanceTable.h"
+
+class USplineComponent;
+class IMappedFileHandle;
+class IMappedFileRegion;
+class IFileHandle;
+
+// Fixed size record per spline in a cooked spline library, followed in the file by its samples
+struct FSplineLibraryEntry
+{
+    // World space bounds of the baked samples
+    FVector3f BoundsMin;
+    FVector3f BoundsMax;
+
+    float SplineLength;
+    uint32 NumSamples;
+
+    // 16 byte aligned file offset of NumSamples locations (FVector3f), followed by NumSamples rotations (FQuat4f)
+    // starting at the next 16 byte boundary
+    uint64 SamplesOffset;
+};
+
+// Streamed samples are read into an aligned buffer, so the rotations can be viewed in place like mapped ones
+using FSplineLibrarySampleBuffer = TArray<uint8, TAlignedHeapAllocator<16>>;
+
+// Read-only library of splines baked into world space distance tables, for large road and rail networks.
+// The file is memory mapped where the platform supports it and read on demand otherwise. Only the index is
+// resident after opening, a spline's samples are paged in when its table is first acquired and dropped
+// again once the last user releases it
+class SPLINETOOLS_API FSplineLibrary
+{
+public:
+    ~FSplineLibrary();
+
+    // Bake Splines into a library file, see FSplineDistanceTable::Build for the sampling settings
+    static bool Write(const FString& Filename, TConstArrayView<const USplineComponent*> Splines, float SampleSpacing, float MaxError);
+
+    static TSharedPtr<FSplineLibrary> Open(const FString& Filename);
+
+    int32 Num() const { return NumSplines; }
+
+    FBox GetBounds(int32 SplineIndex) const;
+
+    // Indices of the splines whose bounds intersect Box
+    void FindSplinesInBox(const FBox& Box, TArray<int32>& OutSplineIndices) const;
+
+    // World space distance table of a spline, shared while any user holds it. Game thread only
+    TSharedPtr<const FSplineDistanceTable> AcquireTable(int32 SplineIndex);
+
+    // Splines whose samples are currently loaded
+    int32 GetNumResidentSplines() const;
+
+private:
+    FSplineLibrary();
+
+    bool ReadSamples(const FSplineLibraryEntry& Entry, FSplineLibrarySampleBuffer& OutBuffer, const uint8*& OutSamples);
+
+    FString Filename;
+    int32 NumSplines = 0;
+
+    // Either the whole file is mapped and the index stays mapped, or the index is read into IndexBuffer
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> MappedIndex;
+    TUniquePtr<IFileHandle> StreamedFile;
+    TArray<uint8> IndexBuffer;
+
+    const FSplineLibraryEntry* Entries = nullptr;
+
+    TMap<int32, TWeakPtr<const FSplineDistanceTable>> ResidentTables;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SplineLibrary.h"
+#include "SplineLibrarySubsystem.generated.h"
+
+class USplineComponent;
+
+DECLARE_MULTICAST_DELEGATE(FOnSplineLibraryChanged);
+
+// Gives followers access to a cooked spline library without spawning spline actors
+UCLASS()
+class SPLINETOOLS_API USplineLibrarySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Deinitialize() override;
+
+    // Open a library written by WriteLibrary, replacing the open one. Tables acquired before stay valid
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    bool OpenLibrary(const FString& Filename);
+
+    // Bake Splines into a library file in world space
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    static bool WriteLibrary(const FString& Filename, const TArray<USplineComponent*>& Splines, float SampleSpacing = 50.0f, float MaxError = 1.0f);
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    int32 GetNumLibrarySplines() const;
+
+    // Library splines whose bounds intersect Box, used to spawn followers by region
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    TArray<int32> FindSplinesInBox(const FBox& Box) const;
+
+    // World space table of a library spline, paged in on first use and kept while referenced
+    TSharedPtr<const FSplineDistanceTable> AcquireSplineTable(int32 SplineIndex);
+
+    const TSharedPtr<FSplineLibrary>& GetLibrary() const { return Library; }
+
+    // Broadcast after OpenLibrary replaced the library, spline indices of the previous one no longer apply
+    FOnSplineLibraryChanged OnLibraryChanged;
+
+private:
+    TSharedPtr<FSplineLibrary> Library;
+};
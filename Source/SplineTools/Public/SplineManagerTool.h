@@ -2,12 +2,106 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
-#include "TimerManager.h"
+#include "UObject/ObjectKey.h"
 #include "SplineTrackerActor.h"
 #include "SplineCharacterFollower.h"
 #include "SplineManagerTool.generated.h"
 
 class ASplineTrackerActor;
+class ULevel;
+class UWorld;
+class FTransactionObjectEvent;
+
+// Tracked actors bucketed by class and tags, so a global spline only visits the actors it can be copied to.
+// Actors are held weakly, an undone placement or an unloaded cell removes them without a delete notification
+template<typename T>
+struct TSplineTrackerGroups
+{
+    static uint32 GetGroupKey(const T* Actor)
+    {
+        uint32 Key = GetTypeHash(Actor->GetClass());
+        for (const FName& Tag : Actor->Tags)
+        {
+            Key = HashCombine(Key, GetTypeHash(Tag));
+        }
+        return Key;
+    }
+
+    void Add(T* Actor)
+    {
+        if (Actor && !GroupKeys.Contains(Actor))
+        {
+            const uint32 Key = GetGroupKey(Actor);
+            GroupKeys.Add(Actor, Key);
+            Groups.FindOrAdd(Key).Add(Actor);
+        }
+    }
+
+    void Remove(T* Actor)
+    {
+        uint32 Key;
+        if (GroupKeys.RemoveAndCopyValue(Actor, Key))
+        {
+            TArray<TWeakObjectPtr<T>>& Group = Groups.FindChecked(Key);
+            Group.RemoveSingleSwap(Actor);
+            if (Group.Num() == 0)
+            {
+                Groups.Remove(Key);
+            }
+        }
+    }
+
+    // Move the actor to another bucket after its tags changed
+    void Regroup(T* Actor)
+    {
+        const uint32* Key = GroupKeys.Find(Actor);
+        if (Key && *Key != GetGroupKey(Actor))
+        {
+            Remove(Actor);
+            Add(Actor);
+        }
+    }
+
+    // Drop actors that went away without being removed
+    void RemoveStale()
+    {
+        for (auto It = GroupKeys.CreateIterator(); It; ++It)
+        {
+            if (!It.Key().ResolveObjectPtr())
+            {
+                TArray<TWeakObjectPtr<T>>& Group = Groups.FindChecked(It.Value());
+                Group.RemoveAllSwap([](const TWeakObjectPtr<T>& Member) { return !Member.IsValid(); });
+                if (Group.Num() == 0)
+                {
+                    Groups.Remove(It.Value());
+                }
+                It.RemoveCurrent();
+            }
+        }
+    }
+
+    // Actors sharing the group of Actor, hash collisions are left to the caller's class and tag comparison.
+    // Members may have gone away since, check them before use
+    const TArray<TWeakObjectPtr<T>>* Find(const T* Actor) const
+    {
+        return Actor ? Groups.Find(GetGroupKey(Actor)) : nullptr;
+    }
+
+    bool Contains(const T* Actor) const
+    {
+        return GroupKeys.Contains(Actor);
+    }
+
+    void Reset()
+    {
+        Groups.Reset();
+        GroupKeys.Reset();
+    }
+
+private:
+    TMap<uint32, TArray<TWeakObjectPtr<T>>> Groups;
+    TMap<TObjectKey<T>, uint32> GroupKeys;
+};
 
 UCLASS()
 class SPLINETOOLS_API USplineManagerTool : public UObject
@@ -28,26 +122,61 @@ public:
 
     // Handle selection changes in the editor
     void OnSelectionChanged(UObject* NewSelection);
+
+    // Propagate the global splines again if their points changed since they were last propagated
     void CheckForSplineUpdates();
     void ApplyGlobalSplineToAllSplines(ASplineTrackerActor* SourceSplineActor);
     void ApplyGlobalSplineToAllSplines(ASplineCharacterFollower* SourceSplineCharacter);
 
+    int32 GetNumTrackedSplines() const { return AllTrackedSplines.Num(); }
+    int32 GetNumTrackedCharacters() const { return AllTrackedCharacters.Num(); }
+
+    // Bake every tracked spline into a spline library file for USplineLibrarySubsystem
+    bool ExportSplineLibrary(const FString& Filename, float SampleSpacing = 50.0f, float MaxError = 1.0f) const;
+
 private:
+    // Registry updates from editor actor and level events
+    void TrackActor(AActor* Actor);
+    void UntrackActor(AActor* Actor);
+    void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+    void OnLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+
+    // Edits to the global splines arrive as property change notifications, e.g. from the spline visualizer
+    void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+    void OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& TransactionEvent);
+
+    // Move a tracked actor to the group matching its current tags
+    void RegroupActor(UObject* Object);
+
+    // Hash of the spline curves that are copied, equal hashes mean there is nothing to copy
+    static uint32 HashSplinePoints(const USplineComponent* Spline);
+
     // Static instance of the tool
     static USplineManagerTool* Instance;
 
     // Current selected global spline actor
-    ASplineTrackerActor* CurrentGlobalSplineActor;
-    ASplineCharacterFollower* CurrentGlobalSplineCharacter;
+    TWeakObjectPtr<ASplineTrackerActor> CurrentGlobalSplineActor;
+    TWeakObjectPtr<ASplineCharacterFollower> CurrentGlobalSplineCharacter;
+
+    // List of all tracked spline actors in the scene, held weakly like the groups
+    TSet<TWeakObjectPtr<ASplineTrackerActor>> AllTrackedSplines;
+    TSet<TWeakObjectPtr<ASplineCharacterFollower>> AllTrackedCharacters;
+
+    // AllTrackedSplines and AllTrackedCharacters grouped by class and tags
+    TSplineTrackerGroups<ASplineTrackerActor> SplineGroups;
+    TSplineTrackerGroups<ASplineCharacterFollower> CharacterGroups;
+
+    // Hash of each global spline when it was last propagated
+    uint32 LastGlobalSplineHash = 0;
+    uint32 LastGlobalCharacterHash = 0;
 
-    // List of all tracked spline actors in the scene
-    TArray<ASplineTrackerActor*> AllTrackedSplines;
-    TArray<ASplineCharacterFollower*> AllTrackedCharacters;
+    // Set while copying so the copies' own notifications are ignored
+    bool bIsPropagating = false;
 
-    // Timer handle for periodic updates
-    FTimerHandle UpdateTimerHandle;
+    // Set once the world was scanned and the registry events are bound
+    bool bIsInitialized = false;
 
     bool bHasModifications;
     template<typename T>
-    void ApplyGlobalSpline(T* SourceSpline, TArray<T*>& TrackedSplines);
+    void ApplyGlobalSpline(T* SourceSpline, const TSplineTrackerGroups<T>& TrackedGroups);
 };
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "SplineMovementComponent.generated.h"
+
+// Custom movement modes of USplineMovementComponent, used with MOVE_Custom
+UENUM(BlueprintType)
+enum class ESplineCustomMovementMode : uint8
+{
+    // Moved along a spline by its owner, without floor finding or sweeps
+    Rails = 0,
+};
+
+// Character movement that hands the character over to its spline follower while on rails.
+// The character movement tick, its floor checks and sweeps are disabled on rails and movement
+// is not replicated, clients derive the position from the replicated follow state instead
+UCLASS(ClassGroup = (Movement), meta = (BlueprintSpawnableComponent))
+class SPLINETOOLS_API USplineMovementComponent : public UCharacterMovementComponent
+{
+    GENERATED_BODY()
+
+public:
+    // Enter or leave the rails mode, leaving restores walking or falling
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    void SetOnRails(bool bOnRails);
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    bool IsOnRails() const;
+
+    // Move the character to a spline transform without sweeps. Velocity follows the move so animation keeps working
+    void MoveAlongSpline(const FVector& NewLocation, const FQuat& NewRotation, float DeltaTime, ETeleportType Teleport);
+
+protected:
+    virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SplineNetwork.generated.h"
+
+class ASplineTrackerActor;
+class USplineComponent;
+
+DECLARE_MULTICAST_DELEGATE(FOnSplineNetworkChanged);
+
+// Directed section of one spline between two junctions
+struct FSplineNetworkEdge
+{
+    int32 FromNode = INDEX_NONE;
+    int32 ToNode = INDEX_NONE;
+    int32 SplineIndex = INDEX_NONE;
+
+    // Spline points at both ends in travel direction. EndPoint wraps past the last point on closed loops
+    int32 StartPoint = 0;
+    int32 EndPoint = 0;
+
+    // Length of the section
+    float Cost = 0.0f;
+};
+
+// Cheapest paths from one node to every other node, kept until the graph changes
+struct FSplinePathTree
+{
+    TArray<float> Costs;
+    TArray<int32> PreviousEdges;
+};
+
+// Connects tracker splines at junctions into a graph that followers can route through. Junctions are spline
+// points shared by several splines within JunctionTolerance, plus the ends of open splines. Shortest paths are
+// cached per start node and route splines per start and goal node until the graph is rebuilt. Place the network
+// in the level so servers and clients build the same graph from the same splines
+UCLASS()
+class SPLINETOOLS_API ASplineNetwork : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    ASplineNetwork();
+
+    UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "Spline Properties")
+    TArray<ASplineTrackerActor*> Splines;
+
+    // Spline points closer than this are joined into one junction
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties", meta = (ClampMin = "0.1"))
+    float JunctionTolerance = 10.0f;
+
+    // Allow travel against the spline direction
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties")
+    bool bBidirectional = true;
+
+    // Start nodes whose shortest path trees are kept, the cache is cleared when it grows past this
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance", meta = (ClampMin = "1"))
+    int32 MaxCachedPathTrees = 256;
+
+    // Rebuild junctions and edges from Splines, invalidating every cached path and route spline. Queries rebuild
+    // on their own once a member spline is destroyed or edited, changes to Splines itself need a call
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    void RebuildGraph();
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    int32 GetNumNodes() const { return NodeLocations.Num(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    FVector GetNodeLocation(int32 Node) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    int32 FindNearestNode(const FVector& Location) const;
+
+    // Edges of the cheapest path from FromNode to ToNode, false when ToNode cannot be reached
+    bool FindPath(int32 FromNode, int32 ToNode, TArray<int32>& OutEdges);
+
+    // Length of the cheapest path, negative when ToNode cannot be reached
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    float GetPathCost(int32 FromNode, int32 ToNode);
+
+    // One spline along the cheapest path, shared by every follower on the same route
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    USplineComponent* GetRouteSpline(int32 FromNode, int32 ToNode);
+
+    const TArray<FSplineNetworkEdge>& GetEdges() const { return Edges; }
+
+    // Incremented on every rebuild
+    uint32 GetGraphVersion() const { return GraphVersion; }
+
+    // Broadcast after a rebuild and on EndPlay, route splines handed out before are destroyed by then
+    FOnSplineNetworkChanged OnGraphChanged;
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    void BuildNodes(TArray<TArray<int32>>& OutPointNodes);
+    void BuildEdges(const TArray<TArray<int32>>& PointNodes);
+    void AddEdge(int32 SplineIndex, int32 StartPoint, int32 EndPoint, int32 FromNode, int32 ToNode, float Cost);
+
+    // Rebuild when a member spline was destroyed or its curves were edited since the last build
+    void RebuildGraphIfStale();
+    bool IsGraphStale() const;
+
+    const FSplinePathTree& FindOrBuildPathTree(int32 FromNode);
+    USplineComponent* CreateRouteSpline(const TArray<int32>& PathEdges);
+    void ClearRouteSplines();
+
+    TArray<FVector> NodeLocations;
+
+    // Edges sorted by FromNode, the outgoing edges of node N are [NodeFirstEdges[N], NodeFirstEdges[N + 1])
+    TArray<FSplineNetworkEdge> Edges;
+    TArray<int32> NodeFirstEdges;
+
+    TMap<int32, FSplinePathTree> PathTrees;
+
+    UPROPERTY(Transient)
+    TMap<int64, USplineComponent*> RouteSplines;
+
+    // Spline components the graph was built from and their curve versions at that time
+    TArray<TWeakObjectPtr<const USplineComponent>> BuiltSplines;
+    TArray<uint32> BuiltSplineVersions;
+
+    uint32 GraphVersion = 0;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class USplineComponent;
+
+// A spline's position curve baked into cubic polynomial coefficients per segment, stored as
+// packed float arrays per axis, so many distances can be evaluated four lanes at a time
+struct SPLINETOOLS_API FSplinePackedCurve
+{
+    // Number of distances evaluated per vector register
+    static constexpr int32 LaneCount = 4;
+
+    void Build(const USplineComponent& Spline);
+
+    // True when the curve was baked from this spline and its current curve data
+    bool IsUpToDate(const USplineComponent& Spline) const;
+
+    bool IsValid() const { return NumSegments > 0 && ReparamDistances.Num() >= 2; }
+
+    float GetSplineLength() const { return SplineLength; }
+
+    // Component space location and tangent at one distance, matching GetLocationAtDistanceAlongSpline
+    // and GetTangentAtDistanceAlongSpline within float precision. Zero while the curve is not valid
+    void Evaluate(float Distance, FVector& OutLocation, FVector& OutTangent) const;
+
+    // Component space locations and tangents for every distance, four at a time with vector intrinsics
+    void EvaluateBatch(TArrayView<const float> Distances, TArrayView<FVector> OutLocations, TArrayView<FVector> OutTangents) const;
+
+private:
+    // Segment index plus the parameter inside it, linear in the spline input key
+    float GetSegmentParameter(float Distance) const;
+
+    void EvaluateLanes(const float* Distances, FVector* OutLocations, FVector* OutTangents) const;
+
+    // Position = ((A * T + B) * T + C) * T + D per axis and segment
+    TArray<float> AX, AY, AZ;
+    TArray<float> BX, BY, BZ;
+    TArray<float> CX, CY, CZ;
+    TArray<float> DX, DY, DZ;
+
+    // Converts tangents from per segment parameter to per input key
+    TArray<float> InvKeyRanges;
+
+    // Distance to segment parameter, baked from the spline's reparam table
+    TArray<float> ReparamDistances;
+    TArray<float> ReparamParameters;
+
+    int32 NumSegments = 0;
+    float SplineLength = 0.0f;
+
+    // Spline, curve version and point count the curve was baked from
+    TObjectKey<USplineComponent> SourceSpline;
+    uint32 SplineVersion = 0;
+    int32 NumSplinePoints = 0;
+    bool bClosedLoop = false;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "SplinePoseSharingSubsystem.generated.h"
+
+class USplineComponent;
+class USkeletalMesh;
+class USkeletalMeshComponent;
+
+// Followers on the same path with the same mesh and animation can reuse one evaluated pose. The path is
+// keyed by curve content and placement, since most followers ride on their own copy of a spline
+struct SPLINETOOLS_API FSplinePoseGroupKey
+{
+    uint32 PathHash = 0;
+    TObjectKey<USkeletalMesh> Mesh;
+    TObjectKey<UObject> Animation;
+
+    bool operator==(const FSplinePoseGroupKey& Other) const
+    {
+        return PathHash == Other.PathHash && Mesh == Other.Mesh && Animation == Other.Animation;
+    }
+
+    bool operator!=(const FSplinePoseGroupKey& Other) const
+    {
+        return !(*this == Other);
+    }
+
+    friend uint32 GetTypeHash(const FSplinePoseGroupKey& Key)
+    {
+        return HashCombine(HashCombine(Key.PathHash, GetTypeHash(Key.Mesh)), GetTypeHash(Key.Animation));
+    }
+};
+
+// Assigns leader poses to skeletal spline followers and counts how many poses are actually evaluated
+UCLASS()
+class SPLINETOOLS_API USplinePoseSharingSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Deinitialize() override;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Build the grouping key for a follower's mesh component on a spline
+    static FSplinePoseGroupKey MakeGroupKey(const USplineComponent* Spline, const USkeletalMeshComponent* MeshComponent);
+
+    // Join a pose group, every leader drives up to FollowersPerLeader other members
+    void RegisterFollower(USkeletalMeshComponent* MeshComponent, const FSplinePoseGroupKey& Key, int32 FollowersPerLeader);
+    void UnregisterFollower(USkeletalMeshComponent* MeshComponent, const FSplinePoseGroupKey& Key);
+
+    // Count pose evaluations of a follower mesh, whether or not it shares its pose
+    void TrackPoseEvaluations(USkeletalMeshComponent* MeshComponent);
+    void UntrackPoseEvaluations(USkeletalMeshComponent* MeshComponent);
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    int32 GetNumEvaluatedPosesLastFrame() const { return EvaluatedPosesLastFrame; }
+
+private:
+    struct FPoseGroup
+    {
+        // Members[k * ChunkSize] leads the members up to the next multiple of ChunkSize
+        TArray<TWeakObjectPtr<USkeletalMeshComponent>> Members;
+        int32 ChunkSize = 1;
+    };
+
+    void AssignLeaders(FPoseGroup& Group, int32 FirstMember);
+    void OnPoseEvaluated();
+
+    TMap<FSplinePoseGroupKey, FPoseGroup> Groups;
+
+    int32 EvaluatedPosesThisFrame = 0;
+    int32 EvaluatedPosesLastFrame = 0;
+};
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class USplineComponent;
+
+// Bounding volume hierarchy over item boxes, rebuilt from scratch or refit in place when boxes move
+class SPLINETOOLS_API FSplineBoundingVolumeHierarchy
+{
+public:
+    static constexpr int32 MaxLeafItems = 4;
+
+    void Build(TConstArrayView<FBox> ItemBounds);
+
+    // Update node bounds for moved items without changing the tree, items must stay the same
+    void Refit(TConstArrayView<FBox> ItemBounds);
+
+    bool IsEmpty() const { return Nodes.Num() == 0; }
+
+    FBox GetBounds() const { return Nodes.Num() > 0 ? Nodes[0].Bounds : FBox(ForceInit); }
+
+    // Visit items closest first until no node can be closer than InOutBestDistanceSquared.
+    // VisitItem(ItemIndex, InOutBestDistanceSquared) lowers the best distance when the item is closer
+    template<typename FVisitItem>
+    void FindNearest(const FVector& Point, double& InOutBestDistanceSquared, FVisitItem&& VisitItem) const
+    {
+        if (Nodes.Num() == 0)
+        {
+            return;
+        }
+
+        typedef TPair<double, int32> FOpenNode;
+        const auto CloserFirst = [](const FOpenNode& A, const FOpenNode& B) { return A.Key < B.Key; };
+
+        TArray<FOpenNode, TInlineAllocator<64>> Open;
+        Open.HeapPush(FOpenNode(Nodes[0].Bounds.ComputeSquaredDistanceToPoint(Point), 0), CloserFirst);
+
+        while (Open.Num() > 0)
+        {
+            FOpenNode Current;
+            Open.HeapPop(Current, CloserFirst);
+
+            if (Current.Key > InOutBestDistanceSquared)
+            {
+                break;
+            }
+
+            const FNode& Node = Nodes[Current.Value];
+            if (Node.NumItems > 0)
+            {
+                for (int32 i = Node.First; i < Node.First + Node.NumItems; ++i)
+                {
+                    VisitItem(Items[i], InOutBestDistanceSquared);
+                }
+                continue;
+            }
+
+            for (int32 Child = Node.First; Child <= Node.First + 1; ++Child)
+            {
+                const double ChildDistanceSquared = Nodes[Child].Bounds.ComputeSquaredDistanceToPoint(Point);
+                if (ChildDistanceSquared <= InOutBestDistanceSquared)
+                {
+                    Open.HeapPush(FOpenNode(ChildDistanceSquared, Child), CloserFirst);
+                }
+            }
+        }
+    }
+
+    // Visit every item whose box is within Radius of Center
+    template<typename FVisitItem>
+    void ForEachInRadius(const FVector& Center, double Radius, FVisitItem&& VisitItem) const
+    {
+        if (Nodes.Num() == 0)
+        {
+            return;
+        }
+
+        const double RadiusSquared = FMath::Square(Radius);
+
+        TArray<int32, TInlineAllocator<64>> Stack;
+        Stack.Add(0);
+
+        while (Stack.Num() > 0)
+        {
+            const FNode& Node = Nodes[Stack.Pop()];
+            if (Node.Bounds.ComputeSquaredDistanceToPoint(Center) > RadiusSquared)
+            {
+                continue;
+            }
+
+            if (Node.NumItems > 0)
+            {
+                for (int32 i = Node.First; i < Node.First + Node.NumItems; ++i)
+                {
+                    VisitItem(Items[i]);
+                }
+            }
+            else
+            {
+                Stack.Add(Node.First);
+                Stack.Add(Node.First + 1);
+            }
+        }
+    }
+
+private:
+    struct FNode
+    {
+        FBox Bounds;
+
+        // Children at First and First + 1 for inner nodes, the range [First, First + NumItems) of Items for leaves
+        int32 First = 0;
+        int32 NumItems = 0;
+    };
+
+    void BuildNode(int32 NodeIndex, int32 Begin, int32 End, TConstArrayView<FBox> ItemBounds);
+
+    TArray<FNode> Nodes;
+    TArray<int32> Items;
+};
+
+// Closest point found on a spline
+struct FSplineSpatialHit
+{
+    USplineComponent* Spline = nullptr;
+
+    // Distance along the spline of the closest point
+    float SplineDistance = 0.0f;
+
+    FVector Location = FVector::ZeroVector;
+    double DistanceSquared = TNumericLimits<double>::Max();
+
+    bool IsValid() const { return Spline != nullptr; }
+};
+
+// Two level spatial index over many splines for nearest spline, nearest distance and radius queries. Every spline
+// is linearized into a polyline within MaxError and gets its own hierarchy over its segments, a top level hierarchy
+// holds the splines. Editing one spline rebuilds only its own hierarchy and refits the top level
+class SPLINETOOLS_API FSplineSpatialIndex
+{
+public:
+    FSplineSpatialIndex(float InSampleSpacing = 100.0f, float InMaxError = 5.0f)
+        : SampleSpacing(InSampleSpacing)
+        , MaxError(InMaxError)
+    {
+    }
+
+    void AddSpline(USplineComponent* Spline);
+    void RemoveSpline(const USplineComponent* Spline);
+
+    // Rebake one spline after it was edited or moved
+    void UpdateSpline(USplineComponent* Spline);
+
+    // Rebake every spline whose curve or transform changed, returns how many were updated
+    int32 UpdateChangedSplines();
+
+    // Bring the top level hierarchy up to date after splines were added, removed or updated, queries assume it is
+    void Prepare();
+
+    bool FindNearest(const FVector& Location, double MaxDistance, FSplineSpatialHit& OutHit) const;
+
+    // Closest point of every spline within Radius, closest first
+    void FindInRadius(const FVector& Location, double Radius, TArray<FSplineSpatialHit>& OutHits) const;
+
+    // FindNearest for many locations in parallel
+    void FindNearestBatch(TConstArrayView<FVector> Locations, double MaxDistance, TArrayView<FSplineSpatialHit> OutHits) const;
+
+    int32 Num() const { return Splines.Num(); }
+
+private:
+    struct FIndexedSpline
+    {
+        TWeakObjectPtr<USplineComponent> Spline;
+
+        // Still finds the entry after the spline was destroyed
+        TObjectKey<USplineComponent> Key;
+
+        // World space polyline and the distance between its points along the spline
+        TArray<FVector> Points;
+        float PointSpacing = 0.0f;
+
+        FSplineBoundingVolumeHierarchy Segments;
+
+        // Curve version and transform the polyline was baked from
+        uint32 SplineVersion = 0;
+        FTransform ComponentToWorld;
+    };
+
+    void BakeSpline(FIndexedSpline& Indexed, USplineComponent& Spline) const;
+    void FindNearestOnSpline(const FIndexedSpline& Indexed, const FVector& Location, double& InOutBestDistanceSquared, FSplineSpatialHit& OutHit) const;
+
+    float SampleSpacing;
+    float MaxError;
+
+    TArray<FIndexedSpline> Splines;
+    TMap<TObjectKey<USplineComponent>, int32> SplineIndices;
+
+    FSplineBoundingVolumeHierarchy TopLevel;
+    bool bTopLevelNeedsBuild = false;
+    bool bTopLevelNeedsRefit = false;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SplineSpatialIndex.h"
+#include "SplineSpatialIndexSubsystem.generated.h"
+
+class USplineComponent;
+
+USTRUCT(BlueprintType)
+struct SPLINETOOLS_API FSplineQueryResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    USplineComponent* Spline = nullptr;
+
+    // Distance along the spline of the closest point
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    float SplineDistance = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    FVector Location = FVector::ZeroVector;
+
+    // Distance from the query location to the closest point
+    UPROPERTY(BlueprintReadOnly, Category = "Spline Properties")
+    float Distance = 0.0f;
+};
+
+// Answers nearest spline and radius queries over every indexed spline through an FSplineSpatialIndex.
+// Tracker actors add their spline on BeginPlay unless bAddToSpatialIndex is off
+UCLASS()
+class SPLINETOOLS_API USplineSpatialIndexSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Deinitialize() override;
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    void AddSpline(USplineComponent* Spline);
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    void RemoveSpline(USplineComponent* Spline);
+
+    // Rebake a spline after editing its points or moving it at runtime
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    void UpdateSpline(USplineComponent* Spline);
+
+    // Rebake every indexed spline whose curve or transform changed
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    int32 UpdateChangedSplines();
+
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    bool FindNearestSpline(const FVector& Location, float MaxDistance, FSplineQueryResult& OutResult);
+
+    // Closest point of every spline within Radius, closest first
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    TArray<FSplineQueryResult> FindSplinesInRadius(const FVector& Location, float Radius);
+
+    // Nearest spline for every location, results without a spline in MaxDistance have no Spline
+    UFUNCTION(BlueprintCallable, Category = "Spline Properties")
+    TArray<FSplineQueryResult> FindNearestSplines(const TArray<FVector>& Locations, float MaxDistance);
+
+    // Index ready for queries from C++, including FindNearestBatch from worker threads while nothing is changed
+    const FSplineSpatialIndex& GetIndex();
+
+private:
+    static FSplineQueryResult ToQueryResult(const FSplineSpatialHit& Hit);
+
+    FSplineSpatialIndex Index;
+};
@@ -17,6 +17,7 @@ public:
     ASplineTrackerActor();
 
     void BeginPlay() override;
+    void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Properties")
     bool bGlobalOverride;
@@ -39,6 +40,10 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline Properties")
     USplineComponent* SplineComponent;
 
+    // Make the spline findable through USplineSpatialIndexSubsystem queries
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties")
+    bool bAddToSpatialIndex = true;
+
 protected:
     virtual void OnConstruction(const FTransform& Transform) override;
 
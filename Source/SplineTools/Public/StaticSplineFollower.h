@@ -4,6 +4,7 @@
 #include "GameFramework/Actor.h"
 #include "Components/StaticMeshComponent.h"
 #include "SplineFollowerBase.h"
+#include "SplineInstancedFollowerManager.h"
 #include "StaticSplineFollower.generated.h"
 
 UCLASS()
@@ -16,10 +17,35 @@ public:
 
     virtual void OnConstruction(const FTransform& Transform) override;
 
+    virtual void OnReleasedToPool() override;
+    virtual void OnAcquiredFromPool() override;
+
     // Skeletal Mesh Component to hold a Skeletal Mesh
     UPROPERTY(VisibleAnywhere, Category = "Spline Properties")
     UStaticMeshComponent* StaticMeshComponent;
 
+    // Render and move this follower as an instance in the shared ASplineInstancedFollowerManager
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance")
+    bool bUseInstancedRendering = false;
+
+    // Destroy the actor after handing it to the instance manager when nothing else needs it
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Properties|Performance", meta = (EditCondition = "bUseInstancedRendering"))
+    bool bReleaseActorWhenInstanced = true;
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void OnFollowStateChanged() override;
+    virtual void OnFollowedSplineChanged() override;
+
+private:
+    // Hand the current spline and the whole follow state to the instance that renders this follower
+    void ForwardStateToInstance();
+
+    // bAllowRelease lets the actor destroy itself afterwards, never for actors handed out by a pool
+    void HandOffToInstanceManager(bool bAllowRelease);
+    void RemoveInstance();
+    ASplineInstancedFollowerManager* FindInstanceManager() const;
+
+    FSplineInstanceHandle InstanceHandle;
 };
@@ -10,7 +10,7 @@ public class SplineTools : ModuleRules
 
         PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "SplineTools", "UMG", "SplineTools" });
 
-        PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore"});
+        PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore", "NetCore" });
 
         if (Target.bBuildEditor)
         {